@@ -0,0 +1,226 @@
+#ifndef GAMEOFLIFE_ENGINEVERIFIER_H
+#define GAMEOFLIFE_ENGINEVERIFIER_H
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "GameBoard.h"
+
+#define VERIFY_GENERATIONS 2000
+#define VERIFY_SEEDS_PER_SIZE 4
+#define VERIFY_SOUP_DENSITY 0.35
+
+struct VerifyCase {
+    int lines;
+    int cols;
+    uint64_t seed;
+};
+
+struct VerifyResult {
+    bool passed = true;
+    std::string engine;
+    VerifyCase testCase = {0, 0, 0};
+    int generation = -1;
+    int line = -1;
+    int col = -1;
+    std::string detail;
+};
+
+// Compara os motores de simulação com uma implementação de referência, escrita direto a partir de
+// CountNeighbors e das regras do jogo, por VERIFY_GENERATIONS gerações; as células e todas as estatísticas da
+// geração devem bater. Cada caso é um tabuleiro aleatório gerado por uma seed; os casos são divididos entre as
+// threads disponíveis.
+class EngineVerifier {
+public:
+    explicit EngineVerifier(const int generations = VERIFY_GENERATIONS) : _generations(generations) {};
+
+    // Tamanhos variados, incluindo tabuleiros de uma linha ou uma coluna, ímpares e os tamanhos do menu
+    [[nodiscard]] static std::vector<VerifyCase> DefaultCases() {
+        const std::vector<std::pair<int, int>> sizes = {
+            {1, 1}, {1, 2}, {2, 1}, {2, 2}, {1, 3}, {3, 1}, {1, 17}, {17, 1}, {1, 64}, {64, 1},
+            {2, 5}, {5, 2}, {3, 3}, {3, 7}, {7, 3}, {4, 4}, {5, 9}, {13, 11}, {31, 33}, {63, 65},
+            {10, 10}, {25, 25}, {50, 50}, {100, 100}, {97, 131}
+        };
+        std::vector<VerifyCase> cases;
+        for (const auto& size : sizes) {
+            for (int seed = 0; seed < VERIFY_SEEDS_PER_SIZE; seed++) {
+                cases.push_back({size.first, size.second, static_cast<uint64_t>(size.first * 1000003 + size.second * 1009 + seed)});
+            }
+        }
+        return cases;
+    };
+
+    // Retorna o número de casos com divergência e escreve um relatório em out
+    int Run(const std::vector<VerifyCase>& cases, std::ostream& out) const {
+        const unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<VerifyResult> results(cases.size());
+        std::atomic<size_t> next(0);
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threadCount; t++) {
+            workers.emplace_back([&]() {
+                for (size_t i = next++; i < cases.size(); i = next++) {
+                    results[i] = CheckCase(cases[i]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        int failures = 0;
+        for (const auto& result : results) {
+            if (result.passed) continue;
+            failures++;
+            out << "FALHA [" << result.engine << "] " << result.testCase.lines << "x" << result.testCase.cols
+            << " seed " << result.testCase.seed << ": geração " << result.generation;
+            if (result.line >= 0) {
+                out << ", célula (" << result.line << ", " << result.col << ")";
+            }
+            out << " - " << result.detail << "\n";
+        }
+        out << cases.size() - failures << "/" << cases.size() << " casos iguais à referência em "
+        << _generations << " gerações (" << threadCount << " threads).\n";
+        return failures;
+    };
+
+private:
+    // Passo de referência: a mesma regra de AdvanceBoardState, célula por célula, usando CountNeighbors.
+    // Sempre roda em um GameBoard<char> de tamanho dinâmico, separado do tabuleiro verificado.
+    static std::vector<char> ReferenceStep(const GameBoard<char>& board, GenerationStats& stats) {
+        const int lines = board.GetLines(), cols = board.GetCols();
+        std::vector<char> next(lines * cols, FALSE_VALUE);
+        stats = GenerationStats();
+        for (int line = 0; line < lines; line++) {
+            for (int col = 0; col < cols; col++) {
+                const int neighbors = board.CountNeighbors(line, col);
+                const bool wasAlive = board(line, col) == TRUE_VALUE;
+                const bool alive = neighbors == 3 || (wasAlive && neighbors == 2);
+                if (alive && !wasAlive) stats.births++;
+                if (!alive && wasAlive) stats.deaths++;
+                if (!alive) continue;
+
+                next[line * cols + col] = TRUE_VALUE;
+                if (stats.population++ == 0) {
+                    stats.minLine = stats.maxLine = line;
+                    stats.minCol = stats.maxCol = col;
+                }
+                stats.minCol = std::min(stats.minCol, col);
+                stats.maxCol = std::max(stats.maxCol, col);
+                stats.maxLine = line;
+            }
+        }
+        return next;
+    };
+
+    VerifyResult CheckCase(const VerifyCase& testCase) const {
+        VerifyResult result = CompareEngine(GameBoard<char>(testCase.lines, testCase.cols), "dinâmico", testCase);
+        if (!result.passed) {
+            return result;
+        }
+        return CompareFixed(testCase);
+    };
+
+    // Os tamanhos do menu também são verificados com a especialização de tamanho fixo
+    VerifyResult CompareFixed(const VerifyCase& testCase) const {
+        if (testCase.lines != testCase.cols) return {};
+        switch (testCase.lines) {
+            case 10: return CompareEngine(GameBoard<char, 10, 10>(), "fixo 10x10", testCase);
+            case 25: return CompareEngine(GameBoard<char, 25, 25>(), "fixo 25x25", testCase);
+            case 50: return CompareEngine(GameBoard<char, 50, 50>(), "fixo 50x50", testCase);
+            case 100: return CompareEngine(GameBoard<char, 100, 100>(), "fixo 100x100", testCase);
+            default: return {};
+        }
+    };
+
+    template <typename Board>
+    VerifyResult CompareEngine(Board board, const std::string& engine, const VerifyCase& testCase) const {
+        VerifyResult result;
+        result.engine = engine;
+        result.testCase = testCase;
+
+        board.RandomSoup(0, 0, testCase.lines, testCase.cols, VERIFY_SOUP_DENSITY, testCase.seed);
+        // A referência só lê as células, então elas são copiadas direto, sem passar pelo índice de posições vivas
+        GameBoard<char> reference(testCase.lines, testCase.cols);
+        for (int line = 0; line < testCase.lines; line++) {
+            for (int col = 0; col < testCase.cols; col++) {
+                reference(line, col) = board(line, col);
+            }
+        }
+        int expectedTotal = board.GetTotalCount();
+
+        for (int generation = 1; generation <= _generations; generation++) {
+            GenerationStats expectedStats;
+            const std::vector<char> expected = ReferenceStep(reference, expectedStats);
+            expectedTotal += expectedStats.births;
+            board.AdvanceBoardState();
+
+            for (int line = 0; line < testCase.lines; line++) {
+                for (int col = 0; col < testCase.cols; col++) {
+                    const char expectedCell = expected[line * testCase.cols + col];
+                    if (board(line, col) != expectedCell) {
+                        return Failure(result, generation, line, col, std::string("esperado '") + expectedCell + "'");
+                    }
+                    reference(line, col) = expectedCell;
+                }
+            }
+
+            const std::string detail = CompareStats(board.GetLastStats(), expectedStats);
+            if (!detail.empty()) {
+                return Failure(result, generation, -1, -1, detail);
+            }
+            if (board.GetCurrentCount() != expectedStats.population) {
+                return Failure(result, generation, -1, -1, "população " + std::to_string(board.GetCurrentCount())
+                    + ", esperado " + std::to_string(expectedStats.population));
+            }
+            if (board.GetTotalCount() != expectedTotal) {
+                return Failure(result, generation, -1, -1, "total de vidas " + std::to_string(board.GetTotalCount())
+                    + ", esperado " + std::to_string(expectedTotal));
+            }
+        }
+        return result;
+    };
+
+    // Compara campo a campo; retorna a descrição do primeiro que diverge, ou vazio se todos baterem
+    static std::string CompareStats(const GenerationStats& actual, const GenerationStats& expected) {
+        const std::vector<std::tuple<const char*, int, int>> fields = {
+            {"nascimentos", actual.births, expected.births},
+            {"mortes", actual.deaths, expected.deaths},
+            {"população", actual.population, expected.population},
+            {"minLine", actual.minLine, expected.minLine},
+            {"minCol", actual.minCol, expected.minCol},
+            {"maxLine", actual.maxLine, expected.maxLine},
+            {"maxCol", actual.maxCol, expected.maxCol}
+        };
+        for (const auto& [name, got, want] : fields) {
+            if (got != want) {
+                std::ostringstream detail;
+                detail << "estatística " << name << " " << got << ", esperado " << want;
+                return detail.str();
+            }
+        }
+        return "";
+    };
+
+    static VerifyResult Failure(VerifyResult& result, const int generation, const int line, const int col, const std::string& detail) {
+        result.passed = false;
+        result.generation = generation;
+        result.line = line;
+        result.col = col;
+        result.detail = detail;
+        return result;
+    };
+
+    int _generations;
+};
+
+
+#endif //GAMEOFLIFE_ENGINEVERIFIER_H
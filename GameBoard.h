@@ -4,20 +4,59 @@
 #pragma once
 
 #include "Matrix.h"
+#include "Viewport.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <random>
 #include <set>
+#include <type_traits>
 #include <SDL.h>
 
 #define DEFAULT_BOARD_HEIGHT 50
 #define DEFAULT_BOARD_WIDTH 50
+#define TILE_SIZE 4
+#define LOD_ZOOM_THRESHOLD 1.0
+#define LOD_SHADES 16
+#define DEFAULT_SOUP_DENSITY 0.3
 
-template <typename T>
+// Estatísticas de uma geração, calculadas em AdvanceBoardState
+struct GenerationStats {
+    int births = 0;
+    int deaths = 0;
+    int population = 0;
+    int minLine = -1;
+    int minCol = -1;
+    int maxLine = -1;
+    int maxCol = -1;
+};
+
+// Contagem de células vivas por bloco; o nível 0 agrupa TILE_SIZE x TILE_SIZE células
+// e cada nível seguinte agrupa 2 x 2 blocos do nível anterior
+struct TileLevel {
+    int lines;
+    int cols;
+    std::vector<int> counts;
+};
+
+// Com Lines e Cols iguais a DYNAMIC_SIZE, o tamanho é definido em tempo de execução e as células ficam em um Matrix.
+// Com dimensões fixas, as células ficam em um FixedMatrix dentro do próprio objeto, sem alocação no heap, e as contas
+// de índice e de borda usam constantes. O jogo roda os tamanhos do menu em tabuleiros de tamanho fixo.
+template <typename T, int Lines, int Cols>
 class GameBoard {
 public:
-    GameBoard() : _height(DEFAULT_BOARD_HEIGHT), _width(DEFAULT_BOARD_WIDTH), _totalCount(0),
-    _board(Matrix<T>(_height, _width)), _lifePositions(std::set<std::pair<int, int>>()) {};
+    static constexpr bool IsFixedSize = Lines != DYNAMIC_SIZE;
+    static_assert((Lines == DYNAMIC_SIZE) == (Cols == DYNAMIC_SIZE), "Both board dimensions must be fixed or dynamic");
 
-    GameBoard(const int height, const int width) : _height(height), _width(width), _totalCount(0),
-    _board (Matrix<T>(height, width)), _lifePositions(std::set<std::pair<int, int>>()) {};
+    using Storage = std::conditional_t<IsFixedSize, FixedMatrix<T, Lines, Cols>, Matrix<T>>;
+
+    GameBoard() : GameBoard(IsFixedSize ? Lines : DEFAULT_BOARD_HEIGHT, IsFixedSize ? Cols : DEFAULT_BOARD_WIDTH) {};
+
+    GameBoard(const int height, const int width) : _totalCount(0),
+    _board (MakeStorage(height, width)), _lifePositions(std::set<std::pair<int, int>>()) {
+        BuildTileLevels();
+    };
 
     ~GameBoard() = default;
 
@@ -37,6 +76,15 @@ public:
         return _lifePositions.size();
     };
 
+    [[nodiscard]] const std::set<std::pair<int, int>>& GetLifePositions() const {
+        return _lifePositions;
+    };
+
+    // Células em ordem de linha, GetLines() * GetCols() valores
+    [[nodiscard]] const T* GetCells() const {
+        return _board._data.data();
+    };
+
     [[nodiscard]] int GetTotalCount() const {
         return _totalCount;
     };
@@ -49,19 +97,19 @@ public:
         return _board._cols;
     }
 
-    void Render(SDL_Renderer* renderer, const int squareWid = 1, const int squareHei = 1) const {
-        std::vector<SDL_Rect> liveSquares;
+    void Render(SDL_Renderer* renderer, const Viewport& view) const {
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
 
-        for (auto& coord : _lifePositions) {
-            const int x = coord.first;
-            const int y = coord.second;
-            SDL_Rect square = {y * squareWid, x * squareHei, squareWid, squareHei};
-            liveSquares.push_back(square);
+        const SDL_Rect clip = view.GetScreenRect();
+        SDL_RenderSetClipRect(renderer, &clip);
+        if (view.GetZoom() >= LOD_ZOOM_THRESHOLD) {
+            RenderCells(renderer, view);
         }
-        SDL_RenderFillRects(renderer, liveSquares.data(), static_cast<int>(liveSquares.size()));
+        else {
+            RenderDensity(renderer, view);
+        }
+        SDL_RenderSetClipRect(renderer, nullptr);
     };
 
     [[nodiscard]] int CountNeighbors(const int line, const int col) const {
@@ -69,12 +117,12 @@ public:
         int counter = 0;
 
         for (int lDelta = -1; lDelta <= 1; lDelta++) {
-            if (line + lDelta < 0) currentLine = _height - 1;
-            else if (line + lDelta >= _height) currentLine = 0;
+            if (line + lDelta < 0) currentLine = Height() - 1;
+            else if (line + lDelta >= Height()) currentLine = 0;
             else currentLine = line + lDelta;
             for (int cDelta = -1; cDelta <= 1; cDelta++) {
-                if (col + cDelta < 0) currentCol = _width - 1;
-                else if (col + cDelta >= _width) currentCol = 0;
+                if (col + cDelta < 0) currentCol = Width() - 1;
+                else if (col + cDelta >= Width()) currentCol = 0;
                 else currentCol = col + cDelta;
 
                 if (_board(currentLine, currentCol) == TRUE_VALUE) {
@@ -86,34 +134,97 @@ public:
         return counter;
     };
 
+    // Nascimentos, mortes, população e retângulo envolvente são calculados junto com a geração.
+    // Sem células vivas, o retângulo fica com min = -1 e max = -1.
+    // Lê as células direto das linhas de cima, do meio e de baixo, com as mesmas regras de borda de CountNeighbors.
+    // O laço por célula só faz contas; o conjunto de posições vivas, os blocos e o retângulo são atualizados
+    // depois de cada linha, e só para as linhas que têm alguma mudança ou célula viva.
     void AdvanceBoardState() {
-        _totalCount += _lifePositions.size();
-        Matrix<T> nextBoard(_height, _width);
-        for (int line = 0; line < _height; line++) {
-            for (int col = 0; col < _width; col++) {
-                T currentValue = (*this)(line, col);
-                const int currentNeighbors = CountNeighbors(line, col);
-                if (currentValue == FALSE_VALUE) {
-                    if (currentNeighbors == 3) {
-                        _totalCount++;
-                        nextBoard(line, col) = TRUE_VALUE;
-                        _lifePositions.emplace(line, col);
-                    }
-                }
-                else if (currentValue == TRUE_VALUE) {
-                    if (currentNeighbors == 2 || currentNeighbors == 3) {
-                        _totalCount++;
-                        nextBoard(line, col) = TRUE_VALUE;
+        const int height = Height(), width = Width();
+        Storage nextBoard = MakeStorage(height, width);
+        const T* cells = _board._data.data();
+        T* nextCells = nextBoard._data.data();
+        std::vector<int>& tileCounts = _tileLevels[0].counts;
+        std::fill(tileCounts.begin(), tileCounts.end(), 0);
+
+        // Com uma só linha (ou coluna), as vizinhas de cima e de baixo (ou dos lados) são a própria célula,
+        // que CountNeighbors nunca conta; a soma do bloco 3 x 3 desconta a célula esse número de vezes
+        const int selfCount = (height == 1 ? 3 : 1) * (width == 1 ? 3 : 1);
+
+        int births = 0, deaths = 0;
+        int minLine = height, minCol = width, maxLine = -1, maxCol = -1;
+        for (int line = 0; line < height; line++) {
+            const T* up = cells + (line == 0 ? height - 1 : line - 1) * width;
+            const T* middle = cells + line * width;
+            const T* down = cells + (line == height - 1 ? 0 : line + 1) * width;
+            T* nextRow = nextCells + line * width;
+
+            int rowBirths = 0, rowDeaths = 0, rowAlive = 0;
+            auto step = [&](const int col, const int left, const int right) {
+                const int wasAlive = middle[col] == TRUE_VALUE;
+                const int currentNeighbors =
+                    (up[left] == TRUE_VALUE) + (up[col] == TRUE_VALUE) + (up[right] == TRUE_VALUE) +
+                    (middle[left] == TRUE_VALUE) + (middle[col] == TRUE_VALUE) + (middle[right] == TRUE_VALUE) +
+                    (down[left] == TRUE_VALUE) + (down[col] == TRUE_VALUE) + (down[right] == TRUE_VALUE) -
+                    wasAlive * selfCount;
+
+                const int alive = (currentNeighbors == 3) | (wasAlive & (currentNeighbors == 2));
+                nextRow[col] = alive ? TRUE_VALUE : FALSE_VALUE;
+                rowBirths += alive & (wasAlive ^ 1);
+                rowDeaths += wasAlive & (alive ^ 1);
+                rowAlive += alive;
+            };
+
+            // As bordas dão a volta; no meio da linha, as vizinhas são sempre col - 1 e col + 1
+            step(0, width - 1, width > 1 ? 1 : 0);
+            for (int col = 1; col < width - 1; col++) {
+                step(col, col - 1, col + 1);
+            }
+            if (width > 1) {
+                step(width - 1, width - 2, 0);
+            }
+
+            if (rowBirths + rowDeaths > 0) {
+                for (int col = 0; col < width; col++) {
+                    if (middle[col] == nextRow[col]) continue;
+                    if (nextRow[col] == TRUE_VALUE) {
                         _lifePositions.emplace(line, col);
                     }
                     else {
                         _lifePositions.erase(std::pair<int,int>(line, col));
                     }
                 }
+                births += rowBirths;
+                deaths += rowDeaths;
+            }
+
+            if (rowAlive > 0) {
+                int* tileRow = &tileCounts[(line / TILE_SIZE) * _tileLevels[0].cols];
+                for (int col = 0, tileCol = 0; col < width; col += TILE_SIZE, tileCol++) {
+                    T* tileEnd = nextRow + std::min(col + TILE_SIZE, width);
+                    tileRow[tileCol] += static_cast<int>(std::count(nextRow + col, tileEnd, TRUE_VALUE));
+                }
+
+                int firstLiveCol = 0, lastLiveCol = width - 1;
+                while (nextRow[firstLiveCol] != TRUE_VALUE) firstLiveCol++;
+                while (nextRow[lastLiveCol] != TRUE_VALUE) lastLiveCol--;
+                minLine = std::min(minLine, line);
+                maxLine = line;
+                minCol = std::min(minCol, firstLiveCol);
+                maxCol = std::max(maxCol, lastLiveCol);
             }
         }
 
-        _board = nextBoard;
+        _totalCount += births;
+        _lastStats = {births, deaths, static_cast<int>(_lifePositions.size()),
+            maxLine >= 0 ? minLine : -1, maxLine >= 0 ? minCol : -1, maxLine, maxCol};
+
+        _board = std::move(nextBoard);
+        RebuildUpperTileLevels();
+    };
+
+    [[nodiscard]] const GenerationStats& GetLastStats() const {
+        return _lastStats;
     };
 
     void SaveToFile(std::ofstream& file) const {
@@ -134,34 +245,295 @@ public:
     }
 
     void CreateLife(const int line, const int col) {
-        if (line < 0 || col < 0 || line >= _height || col >= _width) {
+        if (line < 0 || col < 0 || line >= Height() || col >= Width()) {
             throw std::out_of_range("Invalid board positions!");
         }
+        if (_board(line, col) == TRUE_VALUE) {
+            return;
+        }
+        UpdateTiles(line, col, 1);
         _board(line, col) = TRUE_VALUE;
         _lifePositions.emplace(line, col);
         _totalCount++;
     };
 
     void DestroyLife(const int line, const int col) {
-        if (line < 0 || col < 0 || line >= _height || col >= _width) {
+        if (line < 0 || col < 0 || line >= Height() || col >= Width()) {
             throw std::out_of_range("Invalid board positions!");
         }
+        if (_board(line, col) == TRUE_VALUE) {
+            UpdateTiles(line, col, -1);
+        }
         _board(line, col) = FALSE_VALUE;
         _lifePositions.erase(std::pair<int,int>(line, col));
     };
 
     void InitEmpty(int lines, int cols) {
-        _board = Matrix<T>(lines, cols);
-        _height = lines;
-        _width = cols;
+        _board = MakeStorage(lines, cols);
+        _totalCount = 0;
+        _lifePositions.clear();
+        _lastStats = GenerationStats();
+        BuildTileLevels();
+    };
+
+    // As operações em região abaixo recortam o retângulo nos limites do tabuleiro, trabalham linha a linha
+    // direto nas células e só reconstroem o índice de posições vivas uma vez, no final
+    void FillRect(const int line, const int col, const int height, const int width) {
+        SetRect(line, col, height, width, TRUE_VALUE);
+    };
+
+    void ClearRect(const int line, const int col, const int height, const int width) {
+        SetRect(line, col, height, width, FALSE_VALUE);
+    };
+
+    // Sorteia cada célula da região com a probabilidade density de estar viva; a mesma seed gera a mesma sopa.
+    // Cada número aleatório de 64 bits decide 8 células, um byte para cada.
+    void RandomSoup(const int line, const int col, const int height, const int width, const double density, const uint64_t seed) {
+        int firstLine, firstCol, lastLine, lastCol;
+        if (!ClipRect(line, col, height, width, firstLine, firstCol, lastLine, lastCol)) return;
+
+        std::mt19937_64 generator(seed);
+        const int threshold = static_cast<int>(std::clamp(density, 0.0, 1.0) * 256);
+        for (int l = firstLine; l < lastLine; l++) {
+            T* row = &_board._data[l * Width()];
+            uint64_t bits = 0;
+            for (int c = firstCol, used = 8; c < lastCol; c++, used++) {
+                if (used == 8) {
+                    bits = generator();
+                    used = 0;
+                }
+                const bool alive = static_cast<int>(bits & 0xFF) < threshold;
+                bits >>= 8;
+                if (alive && row[c] != TRUE_VALUE) _totalCount++;
+                row[c] = alive ? TRUE_VALUE : FALSE_VALUE;
+            }
+        }
+        RebuildLifeIndex();
+    };
+
+    // Cola o padrão com o canto superior esquerdo em (line, col). Sem xorMode, as células vivas do padrão
+    // são criadas e as demais ficam como estão; com xorMode, as células vivas do padrão invertem o tabuleiro.
+    void PastePattern(const Matrix<T>& pattern, const int line, const int col, const bool xorMode = false) {
+        int firstLine, firstCol, lastLine, lastCol;
+        if (!ClipRect(line, col, pattern._lines, pattern._cols, firstLine, firstCol, lastLine, lastCol)) return;
+
+        for (int l = firstLine; l < lastLine; l++) {
+            T* row = &_board._data[l * Width()];
+            const T* patternRow = pattern._data.data() + (l - line) * pattern._cols;
+            for (int c = firstCol; c < lastCol; c++) {
+                if (patternRow[c - col] != TRUE_VALUE) continue;
+                if (row[c] != TRUE_VALUE) {
+                    row[c] = TRUE_VALUE;
+                    _totalCount++;
+                }
+                else if (xorMode) {
+                    row[c] = FALSE_VALUE;
+                }
+            }
+        }
+        RebuildLifeIndex();
+    };
+
+    // Estado do tabuleiro com um bit por célula, em ordem de linha, 64 células por palavra
+    [[nodiscard]] std::vector<uint64_t> PackCells() const {
+        const int cells = Height() * Width();
+        std::vector<uint64_t> words((cells + 63) / 64, 0);
+        for (int i = 0; i < cells; i++) {
+            if (_board._data[i] == TRUE_VALUE) {
+                words[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        return words;
+    };
+
+    void UnpackCells(const std::vector<uint64_t>& words, const int totalCount) {
+        const int cells = Height() * Width();
+        if (words.size() != static_cast<size_t>((cells + 63) / 64)) {
+            throw std::invalid_argument("Packed board does not match the board size!");
+        }
+        for (int i = 0; i < cells; i++) {
+            _board._data[i] = (words[i / 64] >> (i % 64)) & 1 ? TRUE_VALUE : FALSE_VALUE;
+        }
+        _totalCount = totalCount;
+        RebuildLifeIndex();
     };
 
 private:
-    int _height;
-    int _width;
+    [[nodiscard]] static Storage MakeStorage(const int height, const int width) {
+        if constexpr (IsFixedSize) {
+            if (height != Lines || width != Cols) {
+                throw std::invalid_argument("Fixed-size board cannot be resized!");
+            }
+            return Storage();
+        }
+        else {
+            return Storage(height, width);
+        }
+    };
+
+    [[nodiscard]] int Height() const {
+        if constexpr (IsFixedSize) return Lines;
+        else return _board._lines;
+    };
+
+    [[nodiscard]] int Width() const {
+        if constexpr (IsFixedSize) return Cols;
+        else return _board._cols;
+    };
+
+    [[nodiscard]] bool ClipRect(const int line, const int col, const int height, const int width,
+        int& firstLine, int& firstCol, int& lastLine, int& lastCol) const {
+        firstLine = std::max(line, 0);
+        firstCol = std::max(col, 0);
+        lastLine = std::min(line + height, Height());
+        lastCol = std::min(col + width, Width());
+        return firstLine < lastLine && firstCol < lastCol;
+    };
+
+    void SetRect(const int line, const int col, const int height, const int width, const T value) {
+        int firstLine, firstCol, lastLine, lastCol;
+        if (!ClipRect(line, col, height, width, firstLine, firstCol, lastLine, lastCol)) return;
+
+        for (int l = firstLine; l < lastLine; l++) {
+            T* rowStart = &_board._data[l * Width() + firstCol];
+            T* rowEnd = rowStart + (lastCol - firstCol);
+            if (value == TRUE_VALUE) {
+                _totalCount += static_cast<int>(rowEnd - rowStart - std::count(rowStart, rowEnd, TRUE_VALUE));
+            }
+            std::fill(rowStart, rowEnd, value);
+        }
+        RebuildLifeIndex();
+    };
+
+    // Reconstrói o conjunto de posições vivas e as contagens por bloco a partir das células
+    void RebuildLifeIndex() {
+        _lifePositions.clear();
+        for (int line = 0; line < Height(); line++) {
+            const T* row = &_board._data[line * Width()];
+            for (int col = 0; col < Width(); col++) {
+                if (row[col] == TRUE_VALUE) {
+                    _lifePositions.emplace_hint(_lifePositions.end(), line, col);
+                }
+            }
+        }
+        BuildTileLevels();
+    };
+
+    [[nodiscard]] int TileIndex(const int level, const int line, const int col) const {
+        const TileLevel& tiles = _tileLevels[level];
+        return (line / TILE_SIZE >> level) * tiles.cols + (col / TILE_SIZE >> level);
+    };
+
+    void BuildTileLevels() {
+        _tileLevels.clear();
+        int tileLines = (Height() + TILE_SIZE - 1) / TILE_SIZE;
+        int tileCols = (Width() + TILE_SIZE - 1) / TILE_SIZE;
+        while (true) {
+            _tileLevels.push_back({tileLines, tileCols, std::vector<int>(tileLines * tileCols, 0)});
+            if (tileLines <= 1 && tileCols <= 1) break;
+            tileLines = (tileLines + 1) / 2;
+            tileCols = (tileCols + 1) / 2;
+        }
+        for (auto& coord : _lifePositions) {
+            _tileLevels[0].counts[TileIndex(0, coord.first, coord.second)]++;
+        }
+        RebuildUpperTileLevels();
+    };
+
+    void RebuildUpperTileLevels() {
+        for (size_t level = 1; level < _tileLevels.size(); level++) {
+            const TileLevel& lower = _tileLevels[level - 1];
+            TileLevel& upper = _tileLevels[level];
+            std::fill(upper.counts.begin(), upper.counts.end(), 0);
+            for (int line = 0; line < lower.lines; line++) {
+                for (int col = 0; col < lower.cols; col++) {
+                    upper.counts[(line / 2) * upper.cols + col / 2] += lower.counts[line * lower.cols + col];
+                }
+            }
+        }
+    };
+
+    void UpdateTiles(const int line, const int col, const int delta) {
+        for (size_t level = 0; level < _tileLevels.size(); level++) {
+            _tileLevels[level].counts[TileIndex(static_cast<int>(level), line, col)] += delta;
+        }
+    };
+
+    // Desenha célula por célula, percorrendo apenas a região visível do tabuleiro
+    void RenderCells(SDL_Renderer* renderer, const Viewport& view) const {
+        const int firstLine = view.FirstVisibleLine(), lastLine = view.LastVisibleLine();
+        const int firstCol = view.FirstVisibleCol(), lastCol = view.LastVisibleCol();
+
+        std::vector<int> colEdges;
+        for (int col = firstCol; col <= lastCol; col++) {
+            colEdges.push_back(view.CellToScreenX(col));
+        }
+
+        std::vector<SDL_Rect> liveSquares;
+        for (int line = firstLine; line < lastLine; line++) {
+            const int y = view.CellToScreenY(line);
+            const int squareHei = std::max(view.CellToScreenY(line + 1) - y, 1);
+            const T* row = &_board._data[line * Width()];
+            for (int col = firstCol; col < lastCol; col++) {
+                if (row[col] == TRUE_VALUE) {
+                    const int x = colEdges[col - firstCol];
+                    const int squareWid = std::max(colEdges[col - firstCol + 1] - x, 1);
+                    liveSquares.push_back({x, y, squareWid, squareHei});
+                }
+            }
+        }
+
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+        SDL_RenderFillRects(renderer, liveSquares.data(), static_cast<int>(liveSquares.size()));
+    };
+
+    // Com o zoom afastado, cada bloco de pixels mostra a densidade de vida do bloco de células correspondente,
+    // usando o nível de blocos mais fino que ainda ocupa ao menos um pixel
+    void RenderDensity(SDL_Renderer* renderer, const Viewport& view) const {
+        size_t level = 0;
+        while (level + 1 < _tileLevels.size() && (TILE_SIZE << level) * view.GetZoom() < 1.0) {
+            level++;
+        }
+        const TileLevel& tiles = _tileLevels[level];
+        const int blockSize = TILE_SIZE << level;
+
+        const int firstLine = view.FirstVisibleLine() / blockSize;
+        const int lastLine = std::min((view.LastVisibleLine() + blockSize - 1) / blockSize, tiles.lines);
+        const int firstCol = view.FirstVisibleCol() / blockSize;
+        const int lastCol = std::min((view.LastVisibleCol() + blockSize - 1) / blockSize, tiles.cols);
+
+        std::array<std::vector<SDL_Rect>, LOD_SHADES> shadedBlocks;
+        for (int line = firstLine; line < lastLine; line++) {
+            const int y = view.CellToScreenY(line * blockSize);
+            const int blockHei = std::max(view.CellToScreenY((line + 1) * blockSize) - y, 1);
+            const int cellLines = std::min((line + 1) * blockSize, Height()) - line * blockSize;
+            for (int col = firstCol; col < lastCol; col++) {
+                const int count = tiles.counts[line * tiles.cols + col];
+                if (count == 0) continue;
+
+                const int x = view.CellToScreenX(col * blockSize);
+                const int blockWid = std::max(view.CellToScreenX((col + 1) * blockSize) - x, 1);
+                const int cellCols = std::min((col + 1) * blockSize, Width()) - col * blockSize;
+                const double density = static_cast<double>(count) / (cellLines * cellCols);
+                const int shade = std::clamp(static_cast<int>(std::ceil(density * (LOD_SHADES - 1))), 1, LOD_SHADES - 1);
+                shadedBlocks[shade].push_back({x, y, blockWid, blockHei});
+            }
+        }
+
+        for (int shade = 1; shade < LOD_SHADES; shade++) {
+            const auto& blocks = shadedBlocks[shade];
+            if (blocks.empty()) continue;
+            const auto intensity = static_cast<Uint8>(255 * shade / (LOD_SHADES - 1));
+            SDL_SetRenderDrawColor(renderer, intensity, intensity, intensity, 255);
+            SDL_RenderFillRects(renderer, blocks.data(), static_cast<int>(blocks.size()));
+        }
+    };
+
     int _totalCount;
-    Matrix<T> _board;
+    Storage _board;
     std::set<std::pair<int, int>> _lifePositions;
+    std::vector<TileLevel> _tileLevels;
+    GenerationStats _lastStats;
 };
 
 
@@ -0,0 +1,194 @@
+#ifndef GAMEOFLIFE_HISTORY_H
+#define GAMEOFLIFE_HISTORY_H
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "GameBoard.h"
+
+#define HISTORY_KEYFRAME_INTERVAL 32
+#define HISTORY_MEMORY_LIMIT (64 * 1024 * 1024)
+
+struct HistoryFrame {
+    int generation;
+    int totalCount;
+    bool keyframe;
+    // Quadro-chave: o tabuleiro empacotado; demais quadros: XOR com o quadro anterior. Ambos comprimidos com RLE.
+    std::vector<uint64_t> data;
+};
+
+// Histórico limitado em memória para voltar gerações. A cada HISTORY_KEYFRAME_INTERVAL quadros (menos, se o tabuleiro
+// for grande para o limite) guarda o tabuleiro inteiro; entre eles, só a diferença para o quadro anterior.
+// Passando do limite de memória, os trechos mais antigos (um quadro-chave e suas diferenças) são descartados; se só
+// o trecho mais recente já passa do limite, ele é trocado por um quadro-chave do estado atual.
+class BoardHistory {
+public:
+    explicit BoardHistory(const size_t memoryLimit = HISTORY_MEMORY_LIMIT, const int keyframeInterval = HISTORY_KEYFRAME_INTERVAL) :
+    _memoryLimit(memoryLimit), _keyframeInterval(keyframeInterval), _bytes(0), _sinceKeyframe(0), _overLimit(false) {};
+
+    template <typename T, int Lines, int Cols>
+    void Record(const int generation, const GameBoard<T, Lines, Cols>& board) {
+        std::vector<uint64_t> packed = board.PackCells();
+        const bool keyframe = _frames.empty() || _sinceKeyframe + 1 >= KeyframeInterval(packed.size())
+            || packed.size() != _lastPacked.size();
+
+        HistoryFrame frame = {generation, board.GetTotalCount(), keyframe, {}};
+        if (keyframe) {
+            frame.data = Compress(packed);
+            _sinceKeyframe = 0;
+        }
+        else {
+            std::vector<uint64_t> delta(packed.size());
+            for (size_t i = 0; i < packed.size(); i++) {
+                delta[i] = packed[i] ^ _lastPacked[i];
+            }
+            frame.data = Compress(delta);
+            _sinceKeyframe++;
+        }
+
+        _bytes += FrameBytes(frame);
+        _frames.push_back(std::move(frame));
+        _lastPacked = std::move(packed);
+        _overLimit = false;
+        Trim();
+        assert(GetMemoryUsage() <= _memoryLimit);
+    };
+
+    // Descarta o quadro mais recente e restaura o anterior no tabuleiro. Retorna false se não houver para onde voltar.
+    template <typename T, int Lines, int Cols>
+    bool StepBack(int& generation, GameBoard<T, Lines, Cols>& board) {
+        if (_frames.size() < 2) {
+            return false;
+        }
+        _bytes -= FrameBytes(_frames.back());
+        _frames.pop_back();
+
+        size_t keyframeIndex = _frames.size() - 1;
+        while (!_frames[keyframeIndex].keyframe) {
+            keyframeIndex--;
+        }
+        _sinceKeyframe = static_cast<int>(_frames.size() - 1 - keyframeIndex);
+
+        _lastPacked = Decompress(_frames[keyframeIndex].data);
+        for (size_t i = keyframeIndex + 1; i < _frames.size(); i++) {
+            const std::vector<uint64_t> delta = Decompress(_frames[i].data);
+            for (size_t word = 0; word < delta.size(); word++) {
+                _lastPacked[word] ^= delta[word];
+            }
+        }
+
+        const HistoryFrame& current = _frames.back();
+        board.UnpackCells(_lastPacked, current.totalCount);
+        generation = current.generation;
+        return true;
+    };
+
+    void Clear() {
+        _frames.clear();
+        std::vector<uint64_t>().swap(_lastPacked);
+        _bytes = 0;
+        _sinceKeyframe = 0;
+        _overLimit = false;
+    };
+
+    // Verdadeiro se o último Record não coube no limite nem como um único quadro-chave; até um quadro caber,
+    // não há para onde voltar
+    [[nodiscard]] bool IsOverLimit() const {
+        return _overLimit;
+    };
+
+    // Inclui a cópia descomprimida do estado mais recente, usada para calcular a próxima diferença
+    [[nodiscard]] size_t GetMemoryUsage() const {
+        return _bytes + _lastPacked.capacity() * sizeof(uint64_t);
+    };
+
+private:
+    // Formato: pares (palavras zeradas, palavras literais) seguidos das palavras literais
+    static std::vector<uint64_t> Compress(const std::vector<uint64_t>& words) {
+        std::vector<uint64_t> out;
+        out.push_back(words.size());
+        size_t i = 0;
+        while (i < words.size()) {
+            const size_t zerosStart = i;
+            while (i < words.size() && words[i] == 0) i++;
+            const size_t literalsStart = i;
+            while (i < words.size() && words[i] != 0) i++;
+            out.push_back(literalsStart - zerosStart);
+            out.push_back(i - literalsStart);
+            out.insert(out.end(), words.begin() + static_cast<long>(literalsStart), words.begin() + static_cast<long>(i));
+        }
+        out.shrink_to_fit();
+        return out;
+    };
+
+    static std::vector<uint64_t> Decompress(const std::vector<uint64_t>& data) {
+        std::vector<uint64_t> words(data[0], 0);
+        size_t position = 0;
+        size_t i = 1;
+        while (i < data.size()) {
+            position += data[i];
+            const size_t literals = data[i + 1];
+            std::copy(data.begin() + static_cast<long>(i + 2), data.begin() + static_cast<long>(i + 2 + literals),
+                words.begin() + static_cast<long>(position));
+            position += literals;
+            i += 2 + literals;
+        }
+        return words;
+    };
+
+    static size_t FrameBytes(const HistoryFrame& frame) {
+        return sizeof(HistoryFrame) + frame.data.capacity() * sizeof(uint64_t);
+    };
+
+    // Um trecho no pior caso (todas as diferenças do tamanho do tabuleiro) deve caber na metade do limite
+    [[nodiscard]] int KeyframeInterval(const size_t packedWords) const {
+        const size_t frameBytes = std::max<size_t>(packedWords * sizeof(uint64_t), 1);
+        const size_t fitting = _memoryLimit / (2 * frameBytes);
+        return static_cast<int>(std::clamp<size_t>(fitting, 1, static_cast<size_t>(_keyframeInterval)));
+    };
+
+    void Trim() {
+        while (GetMemoryUsage() > _memoryLimit) {
+            size_t segmentEnd = 1;
+            while (segmentEnd < _frames.size() && !_frames[segmentEnd].keyframe) {
+                segmentEnd++;
+            }
+            if (segmentEnd == _frames.size()) {
+                break;
+            }
+            for (size_t i = 0; i < segmentEnd; i++) {
+                _bytes -= FrameBytes(_frames.front());
+                _frames.pop_front();
+            }
+        }
+
+        if (GetMemoryUsage() > _memoryLimit && _frames.size() > 1) {
+            HistoryFrame restart = {_frames.back().generation, _frames.back().totalCount, true, Compress(_lastPacked)};
+            _frames.clear();
+            _bytes = FrameBytes(restart);
+            _frames.push_back(std::move(restart));
+            _sinceKeyframe = 0;
+        }
+
+        // Nem um único quadro cabe no limite: o histórico fica vazio
+        if (GetMemoryUsage() > _memoryLimit) {
+            Clear();
+            _overLimit = true;
+        }
+    };
+
+    size_t _memoryLimit;
+    int _keyframeInterval;
+    size_t _bytes;
+    int _sinceKeyframe;
+    bool _overLimit;
+    std::deque<HistoryFrame> _frames;
+    std::vector<uint64_t> _lastPacked;
+};
+
+
+#endif //GAMEOFLIFE_HISTORY_H
@@ -3,16 +3,45 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
+#include <string>
 
 #define TRUE_VALUE '1'
 #define FALSE_VALUE '0'
+#define DYNAMIC_SIZE 0
 
-template<typename T>
+template<typename T, int Lines = DYNAMIC_SIZE, int Cols = DYNAMIC_SIZE>
 class GameBoard;
 
+// Índice em ordem de linha de (line, col), comum a Matrix e FixedMatrix; lança out_of_range fora dos limites
+inline int MatrixIndex(const int line, const int col, const int lines, const int cols) {
+    if (line < 0 || col < 0 || line >= lines || col >= cols) {
+        throw std::out_of_range("Invalid matrix positions!"
+        " Line: " + std::to_string(line) + ", Col: " + std::to_string(col)
+        + " (Borders: " + std::to_string(lines - 1) + ", " + std::to_string(cols - 1) + ")"
+        );
+    }
+    return line * cols + col;
+}
+
+template <typename T>
+void PrintMatrix(const T* data, const int lines, const int cols) {
+    for (int i = 0; i < lines; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (data[i * cols + j] == TRUE_VALUE) {
+                std::cout << " 🟩";
+            }
+            else {
+                std::cout << " ⬜";
+            }
+        }
+        std::cout << "\n";
+    }
+}
+
 template <typename T>
 class Matrix {
 public:
@@ -24,37 +53,15 @@ public:
     };
 
     T& operator()(const int line, const int col) {
-        if (line < 0 || col < 0 || line >= _lines || col >= _cols) {
-            throw std::out_of_range("Invalid matrix positions!"
-            " Line: " + std::to_string(line) + ", Col: " + std::to_string(col)
-            + " (Borders: " + std::to_string(_lines - 1) + ", " + std::to_string(_cols - 1) + ")"
-            );
-        }
-        return _data[line * _cols + col];
+        return _data[MatrixIndex(line, col, _lines, _cols)];
     };
 
     T const& operator()(const int line, const int col) const {
-        if (line < 0 || col < 0 || line >= _lines || col >= _cols) {
-            throw std::out_of_range("Invalid matrix positions!"
-            " Line: " + std::to_string(line) + ", Col: " + std::to_string(col)
-            + " (Borders: " + std::to_string(_lines - 1) + ", " + std::to_string(_cols - 1) + ")"
-            );
-        }
-        return _data[line * _cols + col];
+        return _data[MatrixIndex(line, col, _lines, _cols)];
     };
 
     void Print() const {
-        for (int i = 0; i < _lines; i++) {
-            for (int j = 0; j < _cols; j++) {
-                if ((*this)(i, j) == TRUE_VALUE) {
-                    std::cout << " 🟩";
-                }
-                else {
-                    std::cout << " ⬜";
-                }
-            }
-            std::cout << "\n";
-        }
+        PrintMatrix(_data.data(), _lines, _cols);
     };
 
 private:
@@ -62,7 +69,38 @@ private:
     int _cols = 0;
     std::vector<T> _data;
 
-    friend class GameBoard<T>;
+    template <typename U, int Lines, int Cols>
+    friend class GameBoard;
+};
+
+// Matriz com dimensões fixas em tempo de compilação e células guardadas no próprio objeto
+template <typename T, int Lines, int Cols>
+class FixedMatrix {
+public:
+    static_assert(Lines > 0 && Cols > 0, "FixedMatrix dimensions must be positive");
+
+    FixedMatrix() {
+        _data.fill(FALSE_VALUE);
+    };
+
+    T& operator()(const int line, const int col) {
+        return _data[MatrixIndex(line, col, _lines, _cols)];
+    };
+
+    T const& operator()(const int line, const int col) const {
+        return _data[MatrixIndex(line, col, _lines, _cols)];
+    };
+
+    void Print() const {
+        PrintMatrix(_data.data(), _lines, _cols);
+    };
+
+private:
+    static constexpr int _lines = Lines;
+    static constexpr int _cols = Cols;
+    std::array<T, Lines * Cols> _data;
+
+    friend class GameBoard<T, Lines, Cols>;
 };
 
 #endif //GAMEOFLIFE_MATRIX_H
\ No newline at end of file
@@ -4,13 +4,17 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include "VideoManager.h"
 #include "GameBoard.h"
+#include "SaveIndex.h"
+
+#define FILES_PER_PAGE 4
 
 
 class MenuManager {
 public:
-    MenuManager(VideoManager& vm, GameBoard<char>& tb) : _vm(vm), _tb(tb) {};
+    MenuManager(VideoManager& vm, GameBoard<char>& tb, SaveIndex& index) : _vm(vm), _tb(tb), _index(index) {};
 
     [[nodiscard]] static int HandleChoice(const SDL_Point& mousePos, const std::vector<SDL_Rect>& boxes) {
         for (int i = 0; i < boxes.size(); i++) {
@@ -21,79 +25,89 @@ public:
         return -1;
     };
 
+    // Bloqueia até o próximo clique, sem gastar processamento enquanto o usuário não faz nada.
+    // Só redesenha se a janela pedir (ao ser descoberta). Retorna false se o usuário fechar a janela.
+    [[nodiscard]] static bool WaitForClick(SDL_Point& mousePos, const std::function<void()>& redraw) {
+        SDL_Event event;
+        while (SDL_WaitEvent(&event)) {
+            if (event.type == SDL_QUIT) {
+                return false;
+            }
+            if (event.type == SDL_MOUSEBUTTONDOWN) {
+                mousePos = {event.button.x, event.button.y};
+                return true;
+            }
+            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+                redraw();
+            }
+        }
+        return false;
+    };
+
     std::string MainMenu(std::ifstream& in) const {
         if (!std::filesystem::exists(savesPath)) {
             while (!std::filesystem::create_directory(savesPath));
         }
-        SDL_Event event;
+        SDL_Point mousePos;
         int choice = -1;
 
         while (true) {
-            _vm.SetWindowTitle("Game of Life - Main Menu");
             std::vector<SDL_Rect> choiceRects = {};
-            std::vector<std::string> choiceRectText = {"Arquivo Vazio", "Arquivo Salvo", "Sair"};
-
-            _vm.DrawMenu(3, choiceRects, choiceRectText);
-
-            _vm.RenderPresent();
+            const std::vector<std::string> choiceRectText = {"Arquivo Vazio", "Arquivo Salvo", "Sair"};
+            const auto drawMainMenu = [&]() {
+                _vm.SetWindowTitle("Game of Life - Main Menu");
+                choiceRects = {};
+                _vm.DrawMenu(3, choiceRects, choiceRectText);
+                _vm.RenderPresent();
+            };
+            drawMainMenu();
 
             while (choice < 0) {
-                SDL_PollEvent(&event);
-                if (event.type == SDL_QUIT) {
+                if (!WaitForClick(mousePos, drawMainMenu)) {
                     _vm.RenderEndScreen();
                     return "";
                 }
-                if (event.type == SDL_MOUSEBUTTONDOWN) {
-                    SDL_Point mousePos = {event.button.x, event.button.y};
-                    choice = HandleChoice(mousePos, choiceRects) + 1;
-                }
+                choice = HandleChoice(mousePos, choiceRects) + 1;
+                if (choice == 0) choice = -1;
             }
 
             switch (choice) {
                 case 1: {
-                    _vm.SetWindowTitle("Game of Life - Choose a board size");
                     std::vector<SDL_Rect> sizeChoiceRects = {};
-                    std::vector<std::string> sizeChoiceRectTexts = {"10 x 10", "25 x 25", "50 x 50", "100 x 100", "Voltar"};
-                    _vm.ClearWindow();
-                    _vm.DrawMenu(5, sizeChoiceRects, sizeChoiceRectTexts);
-                    _vm.RenderPresent();
-
-                    while (true) {
-                        int sizeChoice = -1;
-
-                        while (sizeChoice < 0) {
-                            SDL_PollEvent(&event);
-                            if (event.type == SDL_QUIT) {
-                                _vm.RenderEndScreen();
-                                return "";
-                            }
-                            if (event.type == SDL_MOUSEBUTTONDOWN) {
-                                SDL_Point mousePos = {event.button.x, event.button.y};
-                                sizeChoice = HandleChoice(mousePos, sizeChoiceRects);
-                            }
-                        }
-                        if (sizeChoice < 4) {
-                            const std::vector<int> canvasSizes = {10, 25, 50, 100};
-                            _tb.InitEmpty(canvasSizes[sizeChoice], canvasSizes[sizeChoice]);
-                            return "0";
+                    const std::vector<std::string> sizeChoiceRectTexts = {"10 x 10", "25 x 25", "50 x 50", "100 x 100", "Voltar"};
+                    const auto drawSizeMenu = [&]() {
+                        _vm.SetWindowTitle("Game of Life - Choose a board size");
+                        sizeChoiceRects = {};
+                        _vm.ClearWindow();
+                        _vm.DrawMenu(5, sizeChoiceRects, sizeChoiceRectTexts);
+                        _vm.RenderPresent();
+                    };
+                    drawSizeMenu();
+
+                    int sizeChoice = -1;
+                    while (sizeChoice < 0) {
+                        if (!WaitForClick(mousePos, drawSizeMenu)) {
+                            _vm.RenderEndScreen();
+                            return "";
                         }
-                        choice = -1;
-                        break;
+                        sizeChoice = HandleChoice(mousePos, sizeChoiceRects);
+                    }
+                    if (sizeChoice < 4) {
+                        // main roda esses tamanhos em tabuleiros de tamanho fixo (GameBoard<char, N, N>)
+                        const std::vector<int> canvasSizes = {10, 25, 50, 100};
+                        _tb.InitEmpty(canvasSizes[sizeChoice], canvasSizes[sizeChoice]);
+                        return "0";
                     }
+                    choice = -1;
                     break;
                 }
                 case 2: {
                     _vm.SetWindowTitle("Game of Life - Choose a file");
-                    std::vector<std::string> savedFiles;
-
-                    SDL_Rect advancePage = {WINDOW_WIDTH * 3 / 4, WINDOW_HEIGHT / 2, WINDOW_WIDTH / 10, WINDOW_HEIGHT / 10};
-
-                    SDL_Rect returnPage = {WINDOW_WIDTH / 4 - WINDOW_WIDTH / 10, WINDOW_HEIGHT / 2, WINDOW_WIDTH / 10, WINDOW_HEIGHT / 10};
 
-
-                    for (const auto& file : std::filesystem::directory_iterator(savesPath)) {
-                        savedFiles.push_back(file.path().string().substr(6));
+                    if (_index.Refresh(savesPath)) {
+                        _index.Store();
                     }
+                    const std::vector<SaveEntry>& savedFiles = _index.GetEntries();
 
                     if (savedFiles.empty()) {
                         _vm.ClearWindow();
@@ -105,84 +119,49 @@ public:
                         break;
                     }
 
-                    sort(savedFiles.begin(), savedFiles.end());
-
-                    while (true) {
-                        int fileChoice = -1;
-                        int currentPage = 0;
+                    SDL_Rect advancePage = {WINDOW_WIDTH - WINDOW_WIDTH / 40 - WINDOW_WIDTH / 10, WINDOW_HEIGHT / 2, WINDOW_WIDTH / 10, WINDOW_HEIGHT / 10};
 
-                        std::vector<SDL_Rect> fileChoiceRects = {};
-                        std::vector<std::string> fileChoiceRectTexts = {};
-                        _vm.ClearWindow();
-                        for (int i = 0; i < 4; i++) {
-                            if (i >= savedFiles.size()) break;
-                            fileChoiceRectTexts.push_back(savedFiles[i]);
-                        }
+                    SDL_Rect returnPage = {WINDOW_WIDTH / 40, WINDOW_HEIGHT / 2, WINDOW_WIDTH / 10, WINDOW_HEIGHT / 10};
 
-                        _vm.DrawMenu(5, fileChoiceRects, fileChoiceRectTexts, true);
-                        _vm.DrawPageChangeArrows(advancePage, returnPage);
-                        _vm.RenderPresent();
+                    int currentPage = 0;
+                    std::vector<SDL_Rect> fileChoiceRects = {};
+                    const auto drawFilePage = [&]() {
+                        fileChoiceRects = {};
+                        DrawFilePage(savedFiles, currentPage, fileChoiceRects, advancePage, returnPage);
+                    };
+                    drawFilePage();
 
-                        while (fileChoice < 0) {
-                            SDL_PollEvent(&event);
-                            if (event.type == SDL_QUIT) {
-                                _vm.RenderEndScreen();
-                                return "";
-                            }
-                            if (event.type == SDL_MOUSEBUTTONDOWN) {
-                                SDL_Point mousePos = {event.button.x, event.button.y};
-                                if (SDL_PointInRect(&mousePos, &advancePage)) {
-                                    if ((currentPage + 1) * 4 < savedFiles.size()) {
-                                        fileChoiceRectTexts = {};
-                                        fileChoiceRects = {};
-                                        currentPage++;
-                                        _vm.ClearWindow();
-                                        for (int i = 0; i < 4; i++) {
-                                            if (currentPage * 4 + i >= savedFiles.size()) {
-                                                break;
-                                            }
-                                            fileChoiceRectTexts.push_back(savedFiles[currentPage * 4 + i]);
-                                        }
-                                        _vm.DrawMenu(5, fileChoiceRects, fileChoiceRectTexts, true);
-                                        _vm.DrawPageChangeArrows(advancePage, returnPage);
-                                        _vm.RenderPresent();
-                                    }
-                                }
-                                else if (SDL_PointInRect(&mousePos, &returnPage)) {
-                                    if (currentPage > 0) {
-                                        fileChoiceRectTexts = {};
-                                        fileChoiceRects = {};
-                                        currentPage--;
-                                        _vm.ClearWindow();
-                                        for (int i = 0; i < 4; i++) {
-                                            if (currentPage * 4 + i >= savedFiles.size()) {
-                                                break;
-                                            }
-                                            fileChoiceRectTexts.push_back(savedFiles[currentPage * 4 + i]);
-                                        }
-                                        _vm.DrawMenu(5, fileChoiceRects, fileChoiceRectTexts, true);
-                                        _vm.DrawPageChangeArrows(advancePage, returnPage);
-                                        _vm.RenderPresent();
-                                    }
-                                }
-                                else {
-                                    fileChoice = HandleChoice(mousePos, fileChoiceRects);
-                                    if (fileChoice + currentPage * 4 >= savedFiles.size() && fileChoice < 4) {
-                                        fileChoice = -1;
-                                    }
-                                }
+                    int fileChoice = -1;
+                    while (fileChoice < 0) {
+                        if (!WaitForClick(mousePos, drawFilePage)) {
+                            _vm.RenderEndScreen();
+                            return "";
+                        }
+                        if (SDL_PointInRect(&mousePos, &advancePage)) {
+                            if ((currentPage + 1) * FILES_PER_PAGE < savedFiles.size()) {
+                                currentPage++;
+                                drawFilePage();
                             }
                         }
-
-                        if (fileChoice < 4) {
-                            fileChoice = 4 * currentPage + fileChoice;
-                            return "saves/" + savedFiles[fileChoice];
+                        else if (SDL_PointInRect(&mousePos, &returnPage)) {
+                            if (currentPage > 0) {
+                                currentPage--;
+                                drawFilePage();
+                            }
                         }
-                        if (fileChoice == 4) {
-                            choice = -1;
-                            break;
+                        else {
+                            fileChoice = HandleChoice(mousePos, fileChoiceRects);
+                            if (fileChoice + currentPage * FILES_PER_PAGE >= savedFiles.size() && fileChoice < FILES_PER_PAGE) {
+                                fileChoice = -1;
+                            }
                         }
                     }
+
+                    if (fileChoice < FILES_PER_PAGE) {
+                        fileChoice = FILES_PER_PAGE * currentPage + fileChoice;
+                        return savesPath + "/" + savedFiles[fileChoice].fileName;
+                    }
+                    choice = -1;
                     break;
                 }
                 case 3: {
@@ -197,10 +176,39 @@ public:
         }
     }
 private:
+    // Desenha uma página do navegador de arquivos com as informações e miniaturas vindas do índice
+    void DrawFilePage(const std::vector<SaveEntry>& savedFiles, const int page, std::vector<SDL_Rect>& fileChoiceRects,
+        const SDL_Rect& advancePage, const SDL_Rect& returnPage) const {
+        std::vector<std::string> fileChoiceRectTexts = {};
+        for (int i = 0; i < FILES_PER_PAGE; i++) {
+            if (page * FILES_PER_PAGE + i >= savedFiles.size()) break;
+            fileChoiceRectTexts.push_back(savedFiles[page * FILES_PER_PAGE + i].fileName);
+        }
+
+        _vm.ClearWindow();
+        _vm.DrawMenu(FILES_PER_PAGE + 1, fileChoiceRects, fileChoiceRectTexts, true);
+
+        for (int i = 0; i < fileChoiceRectTexts.size(); i++) {
+            const SaveEntry& entry = savedFiles[page * FILES_PER_PAGE + i];
+            const SDL_Rect& box = fileChoiceRects[i];
+
+            const SDL_Rect previewRect = {box.x - box.h * 5 / 4, box.y, box.h, box.h};
+            _vm.DrawPreview(previewRect, entry.fileName + ":" + std::to_string(entry.modifiedTime), entry.preview, PREVIEW_SIZE);
+
+            const SDL_Rect infoRect = {box.x + box.w + box.h / 4, box.y + box.h / 4, WINDOW_WIDTH / 6, box.h / 2};
+            _vm.DrawText(infoRect, std::to_string(entry.lines) + "x" + std::to_string(entry.cols) + ", "
+                + std::to_string(entry.population) + " vivas");
+        }
+
+        _vm.DrawPageChangeArrows(advancePage, returnPage);
+        _vm.RenderPresent();
+    };
+
     VideoManager& _vm;
     GameBoard<char>& _tb;
+    SaveIndex& _index;
 
 };
 
 
-#endif //GAMEOFLIFE_MENUMANAGER_H
\ No newline at end of file
+#endif //GAMEOFLIFE_MENUMANAGER_H
@@ -0,0 +1,177 @@
+#ifndef GAMEOFLIFE_SAVEINDEX_H
+#define GAMEOFLIFE_SAVEINDEX_H
+
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include "GameBoard.h"
+
+#define PREVIEW_SIZE 32
+
+const std::string saveIndexPath = "auxi/saveIndex.txt";
+
+struct SaveEntry {
+    std::string fileName;
+    uintmax_t fileSize = 0;
+    long long modifiedTime = 0;
+    int lines = 0;
+    int cols = 0;
+    int population = 0;
+    // Miniatura PREVIEW_SIZE x PREVIEW_SIZE; 1 onde há alguma célula viva na região correspondente
+    std::vector<Uint8> preview;
+};
+
+// Índice persistente dos arquivos salvos: guarda tamanho, população e miniatura de cada arquivo,
+// para que o menu não precise abrir os arquivos a cada vez. Um arquivo só é lido de novo se mudar de tamanho ou data.
+class SaveIndex {
+public:
+    explicit SaveIndex(const std::string& indexPath = saveIndexPath) : _indexPath(indexPath) {};
+
+    void Load() {
+        _entries.clear();
+        std::ifstream in(_indexPath);
+        if (!in.is_open()) {
+            return;
+        }
+
+        SaveEntry entry;
+        while (std::getline(in, entry.fileName)) {
+            std::string previewBits;
+            in >> entry.fileSize >> entry.modifiedTime >> entry.lines >> entry.cols >> entry.population >> previewBits;
+            in.ignore();
+            if (!in || previewBits.size() != PREVIEW_SIZE * PREVIEW_SIZE) {
+                // Índice corrompido: descarta e deixa o Refresh reconstruir a partir dos arquivos
+                _entries.clear();
+                return;
+            }
+            entry.preview.resize(previewBits.size());
+            std::transform(previewBits.begin(), previewBits.end(), entry.preview.begin(),
+                [](const char bit) { return static_cast<Uint8>(bit == TRUE_VALUE); });
+            _entries.push_back(entry);
+        }
+        SortEntries();
+    };
+
+    void Store() const {
+        std::ofstream out(_indexPath);
+        if (!out.is_open()) {
+            throw std::runtime_error("Erro ao abrir o índice de arquivos salvos!");
+        }
+        for (const auto& entry : _entries) {
+            out << entry.fileName << "\n";
+            out << entry.fileSize << " " << entry.modifiedTime << " " << entry.lines << " " << entry.cols << " "
+            << entry.population << " ";
+            for (const Uint8 bit : entry.preview) {
+                out << (bit ? TRUE_VALUE : FALSE_VALUE);
+            }
+            out << "\n";
+        }
+    };
+
+    // Sincroniza o índice com a pasta; só lê os arquivos novos ou alterados. Retorna true se algo mudou.
+    bool Refresh(const std::string& directory) {
+        std::map<std::string, SaveEntry> known;
+        for (auto& entry : _entries) {
+            known.emplace(entry.fileName, std::move(entry));
+        }
+
+        bool changed = false;
+        std::vector<SaveEntry> refreshed;
+        for (const auto& file : std::filesystem::directory_iterator(directory)) {
+            if (!file.is_regular_file()) continue;
+
+            const std::string fileName = file.path().filename().string();
+            const uintmax_t fileSize = file.file_size();
+            const long long modifiedTime = file.last_write_time().time_since_epoch().count();
+
+            auto found = known.find(fileName);
+            if (found != known.end() && found->second.fileSize == fileSize && found->second.modifiedTime == modifiedTime) {
+                refreshed.push_back(std::move(found->second));
+                known.erase(found);
+                continue;
+            }
+
+            SaveEntry entry;
+            if (!ParseSaveFile(file.path(), entry)) continue;
+            entry.fileName = fileName;
+            entry.fileSize = fileSize;
+            entry.modifiedTime = modifiedTime;
+            refreshed.push_back(std::move(entry));
+            changed = true;
+        }
+
+        changed = changed || !known.empty();
+        _entries = std::move(refreshed);
+        SortEntries();
+        return changed;
+    };
+
+    // Registra um arquivo recém-salvo direto do tabuleiro em memória, sem relê-lo do disco
+    template <typename T, int Lines, int Cols>
+    void Record(const std::string& directory, const std::string& fileName, const GameBoard<T, Lines, Cols>& board) {
+        const std::filesystem::path path = std::filesystem::path(directory) / fileName;
+
+        SaveEntry entry;
+        entry.fileName = fileName;
+        entry.fileSize = std::filesystem::file_size(path);
+        entry.modifiedTime = std::filesystem::last_write_time(path).time_since_epoch().count();
+        entry.lines = board.GetLines();
+        entry.cols = board.GetCols();
+        entry.population = board.GetCurrentCount();
+        entry.preview.assign(PREVIEW_SIZE * PREVIEW_SIZE, 0);
+        for (auto& coord : board.GetLifePositions()) {
+            MarkPreview(entry, coord.first, coord.second);
+        }
+
+        _entries.erase(std::remove_if(_entries.begin(), _entries.end(),
+            [&fileName](const SaveEntry& e) { return e.fileName == fileName; }), _entries.end());
+        _entries.push_back(std::move(entry));
+        SortEntries();
+    };
+
+    [[nodiscard]] const std::vector<SaveEntry>& GetEntries() const {
+        return _entries;
+    };
+
+private:
+    static void MarkPreview(SaveEntry& entry, const int line, const int col) {
+        const int previewLine = static_cast<int>(static_cast<long long>(line) * PREVIEW_SIZE / entry.lines);
+        const int previewCol = static_cast<int>(static_cast<long long>(col) * PREVIEW_SIZE / entry.cols);
+        entry.preview[previewLine * PREVIEW_SIZE + previewCol] = 1;
+    };
+
+    static bool ParseSaveFile(const std::filesystem::path& path, SaveEntry& entry) {
+        std::ifstream in(path);
+        int liveCells;
+        if (!(in >> entry.lines >> entry.cols >> liveCells) || entry.lines <= 0 || entry.cols <= 0) {
+            return false;
+        }
+
+        entry.population = 0;
+        entry.preview.assign(PREVIEW_SIZE * PREVIEW_SIZE, 0);
+        int line, col;
+        for (int cell = 0; cell < liveCells && in >> line >> col; cell++) {
+            if (line < 0 || col < 0 || line >= entry.lines || col >= entry.cols) continue;
+            MarkPreview(entry, line, col);
+            entry.population++;
+        }
+        return true;
+    };
+
+    void SortEntries() {
+        std::sort(_entries.begin(), _entries.end(),
+            [](const SaveEntry& a, const SaveEntry& b) { return a.fileName < b.fileName; });
+    };
+
+    std::string _indexPath;
+    std::vector<SaveEntry> _entries;
+};
+
+
+#endif //GAMEOFLIFE_SAVEINDEX_H
@@ -0,0 +1,114 @@
+#ifndef GAMEOFLIFE_SCHEDULER_H
+#define GAMEOFLIFE_SCHEDULER_H
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#define MIN_GENERATIONS_PER_SECOND 1.0
+#define MAX_GENERATIONS_PER_SECOND 1000.0
+#define FRAME_BUDGET_MS 12
+#define MAX_BACKLOG_SECONDS 0.25
+#define MAX_SKIPPED_RENDER_MS 100
+#define RATE_WINDOW_MS 500
+
+// Decide quantas gerações rodar a cada quadro para atingir a velocidade alvo (em gerações por segundo).
+// As gerações de um quadro rodam enquanto couberem em FRAME_BUDGET_MS; se ainda houver gerações atrasadas,
+// o quadro deixa de ser desenhado (até MAX_SKIPPED_RENDER_MS) para a simulação alcançar o alvo.
+class GenerationScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    GenerationScheduler() : _target(MIN_GENERATIONS_PER_SECOND), _turbo(false), _pending(0.0),
+    _lastTick(Clock::now()), _frameStart(_lastTick), _lastRender(_lastTick), _rateWindowStart(_lastTick),
+    _rateWindowGenerations(0), _achievedRate(0.0) {};
+
+    // Converte a posição do círculo de velocidade (0 = embaixo, 1 = em cima) em gerações por segundo,
+    // em escala logarítmica entre os limites
+    [[nodiscard]] static double TargetFromPosition(const double position) {
+        const double clamped = std::clamp(position, 0.0, 1.0);
+        return MIN_GENERATIONS_PER_SECOND * std::pow(MAX_GENERATIONS_PER_SECOND / MIN_GENERATIONS_PER_SECOND, clamped);
+    };
+
+    void SetTarget(const double generationsPerSecond) {
+        _target = std::clamp(generationsPerSecond, MIN_GENERATIONS_PER_SECOND, MAX_GENERATIONS_PER_SECOND);
+    };
+
+    [[nodiscard]] double GetTarget() const {
+        return _target;
+    };
+
+    void ToggleTurbo() {
+        _turbo = !_turbo;
+        _pending = 0.0;
+    };
+
+    [[nodiscard]] bool IsTurbo() const {
+        return _turbo;
+    };
+
+    void BeginFrame(const bool paused) {
+        const auto now = Clock::now();
+        const double elapsed = std::chrono::duration<double>(now - _lastTick).count();
+        _lastTick = now;
+        _frameStart = now;
+
+        if (paused) {
+            _pending = 0.0;
+        }
+        else if (!_turbo) {
+            _pending = std::min(_pending + elapsed * _target, std::max(_target * MAX_BACKLOG_SECONDS, 1.0));
+        }
+
+        const auto windowElapsed = now - _rateWindowStart;
+        if (windowElapsed >= std::chrono::milliseconds(RATE_WINDOW_MS)) {
+            _achievedRate = _rateWindowGenerations / std::chrono::duration<double>(windowElapsed).count();
+            _rateWindowStart = now;
+            _rateWindowGenerations = 0;
+        }
+    };
+
+    [[nodiscard]] bool ShouldStep() const {
+        if (!_turbo && _pending < 1.0) {
+            return false;
+        }
+        return Clock::now() - _frameStart < std::chrono::milliseconds(FRAME_BUDGET_MS);
+    };
+
+    void StepDone() {
+        if (!_turbo) {
+            _pending -= 1.0;
+        }
+        _rateWindowGenerations++;
+    };
+
+    [[nodiscard]] bool ShouldRender() {
+        const auto now = Clock::now();
+        const bool behind = _turbo || _pending >= 1.0;
+        if (behind && now - _lastRender < std::chrono::milliseconds(MAX_SKIPPED_RENDER_MS)) {
+            return false;
+        }
+        _lastRender = now;
+        return true;
+    };
+
+    [[nodiscard]] double GetAchievedRate() const {
+        return _achievedRate;
+    };
+
+private:
+    double _target;
+    bool _turbo;
+    double _pending;
+    Clock::time_point _lastTick;
+    Clock::time_point _frameStart;
+    Clock::time_point _lastRender;
+    Clock::time_point _rateWindowStart;
+    int _rateWindowGenerations;
+    double _achievedRate;
+};
+
+
+#endif //GAMEOFLIFE_SCHEDULER_H
@@ -0,0 +1,190 @@
+#ifndef GAMEOFLIFE_SHAREDBOARD_H
+#define GAMEOFLIFE_SHAREDBOARD_H
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include "GameBoard.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SHARED_BOARD_SUPPORTED 1
+#else
+#define SHARED_BOARD_SUPPORTED 0
+#endif
+
+#define SHARED_BOARD_MAGIC 0x424C4F47u // "GOLB" em little-endian
+#define SHARED_BOARD_VERSION 2u
+
+// Cabeçalho no início da região compartilhada. As células vêm logo depois, a partir de dataOffset:
+// lines * cols bytes em ordem de linha, TRUE_VALUE para vivas e FALSE_VALUE para mortas.
+// writerPid é o processo do jogo que publica na região.
+//
+// Leitura consistente (seqlock): ler sequence (acquire); se for ímpar, o jogo está escrevendo e é preciso tentar
+// de novo. Ler as células e os campos direto da região, sem copiar; depois de uma barreira acquire, ler sequence
+// outra vez. Se mudou, a leitura se misturou com uma escrita e deve ser descartada.
+struct SharedBoardHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t lines;
+    int32_t cols;
+    uint64_t dataOffset;
+    int64_t writerPid;
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> generation;
+    std::atomic<uint64_t> population;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared board counters must be lock-free");
+
+// Publica o tabuleiro em um objeto de memória compartilhada POSIX, para que outros programas o leiam sem a janela
+// e sem passar pelo disco. Cada publicação é uma cópia das células para a região; AdvanceBoardState não muda.
+class SharedBoardPublisher {
+public:
+    template <typename T, int Lines, int Cols>
+    SharedBoardPublisher(const std::string& name, const GameBoard<T, Lines, Cols>& board) :
+    _name(name.empty() || name[0] != '/' ? "/" + name : name), _lines(board.GetLines()), _cols(board.GetCols()),
+    _cellBytes(static_cast<size_t>(_lines) * _cols * sizeof(T)), _size(0), _region(nullptr) {
+#if SHARED_BOARD_SUPPORTED
+        // O_EXCL garante que a região é nova e que o cabeçalho não é reescrito embaixo de quem já a lê.
+        // Se o nome já existe, só é removido e criado de novo quando sobrou de um jogo que não está mais rodando.
+        int descriptor = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (descriptor < 0 && errno == EEXIST) {
+            if (!IsStale(_name)) {
+                throw std::runtime_error("A memória compartilhada " + _name + " já existe e está em uso!");
+            }
+            shm_unlink(_name.c_str());
+            descriptor = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+        if (descriptor < 0) {
+            throw std::runtime_error("Erro ao criar a memória compartilhada " + _name + "!");
+        }
+
+        struct stat created {};
+        fstat(descriptor, &created);
+        _device = created.st_dev;
+        _inode = created.st_ino;
+
+        const size_t dataOffset = (sizeof(SharedBoardHeader) + 63) / 64 * 64;
+        _size = dataOffset + _cellBytes;
+        if (ftruncate(descriptor, static_cast<off_t>(_size)) != 0) {
+            close(descriptor);
+            shm_unlink(_name.c_str());
+            throw std::runtime_error("Erro ao redimensionar a memória compartilhada " + _name + "!");
+        }
+
+        void* region = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        close(descriptor);
+        if (region == MAP_FAILED) {
+            shm_unlink(_name.c_str());
+            throw std::runtime_error("Erro ao mapear a memória compartilhada " + _name + "!");
+        }
+        _region = static_cast<unsigned char*>(region);
+
+        SharedBoardHeader* header = new (_region) SharedBoardHeader;
+        header->magic = SHARED_BOARD_MAGIC;
+        header->version = SHARED_BOARD_VERSION;
+        header->lines = _lines;
+        header->cols = _cols;
+        header->dataOffset = dataOffset;
+        header->writerPid = static_cast<int64_t>(getpid());
+        header->sequence.store(0, std::memory_order_relaxed);
+        header->generation.store(0, std::memory_order_relaxed);
+        header->population.store(0, std::memory_order_relaxed);
+#else
+        throw std::runtime_error("Memória compartilhada não é suportada nesta plataforma!");
+#endif
+    };
+
+    SharedBoardPublisher(const SharedBoardPublisher&) = delete;
+    SharedBoardPublisher& operator=(const SharedBoardPublisher&) = delete;
+
+    ~SharedBoardPublisher() {
+#if SHARED_BOARD_SUPPORTED
+        if (_region) {
+            munmap(_region, _size);
+            // Só remove o nome se ele ainda aponta para a região criada aqui
+            const int descriptor = shm_open(_name.c_str(), O_RDONLY, 0);
+            if (descriptor >= 0) {
+                struct stat current {};
+                const bool ours = fstat(descriptor, &current) == 0 && current.st_dev == _device && current.st_ino == _inode;
+                close(descriptor);
+                if (ours) {
+                    shm_unlink(_name.c_str());
+                }
+            }
+        }
+#endif
+    };
+
+    template <typename T, int Lines, int Cols>
+    void Publish(const int generation, const GameBoard<T, Lines, Cols>& board) {
+        if (board.GetLines() != _lines || board.GetCols() != _cols) {
+            throw std::invalid_argument("Board size does not match the shared region!");
+        }
+        auto* header = reinterpret_cast<SharedBoardHeader*>(_region);
+        const uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+
+        header->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(_region + header->dataOffset, board.GetCells(), _cellBytes);
+        header->generation.store(static_cast<uint64_t>(generation), std::memory_order_relaxed);
+        header->population.store(static_cast<uint64_t>(board.GetCurrentCount()), std::memory_order_relaxed);
+
+        header->sequence.store(sequence + 2, std::memory_order_release);
+    };
+
+private:
+#if SHARED_BOARD_SUPPORTED
+    // Uma região existente está abandonada se tem o nosso formato e o processo que a escrevia não existe mais.
+    // Regiões de outro formato ou de um jogo vivo nunca são removidas.
+    static bool IsStale(const std::string& name) {
+        const int descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+        if (descriptor < 0) {
+            return false;
+        }
+        struct stat existing {};
+        if (fstat(descriptor, &existing) != 0 || existing.st_size < static_cast<off_t>(sizeof(SharedBoardHeader))) {
+            close(descriptor);
+            return false;
+        }
+        void* region = mmap(nullptr, sizeof(SharedBoardHeader), PROT_READ, MAP_SHARED, descriptor, 0);
+        close(descriptor);
+        if (region == MAP_FAILED) {
+            return false;
+        }
+
+        const auto* header = static_cast<const SharedBoardHeader*>(region);
+        const bool ownFormat = header->magic == SHARED_BOARD_MAGIC && header->version == SHARED_BOARD_VERSION;
+        const auto writerPid = static_cast<pid_t>(header->writerPid);
+        munmap(region, sizeof(SharedBoardHeader));
+
+        return ownFormat && writerPid > 0 && kill(writerPid, 0) != 0 && errno == ESRCH;
+    };
+#endif
+
+    std::string _name;
+    int _lines;
+    int _cols;
+    size_t _cellBytes;
+    size_t _size;
+    unsigned char* _region;
+#if SHARED_BOARD_SUPPORTED
+    dev_t _device = 0;
+    ino_t _inode = 0;
+#endif
+};
+
+
+#endif //GAMEOFLIFE_SHAREDBOARD_H
@@ -0,0 +1,95 @@
+#ifndef GAMEOFLIFE_STATISTICS_H
+#define GAMEOFLIFE_STATISTICS_H
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "GameBoard.h"
+
+#define STATS_BUFFER_BYTES (1 << 16)
+
+// Grava as estatísticas de cada geração em CSV. As linhas são acumuladas em um buffer em memória
+// e, quando ele enche, uma thread separada o escreve no disco enquanto a simulação preenche o outro.
+class StatsWriter {
+public:
+    explicit StatsWriter(const std::string& path) : _file(path), _stopping(false) {
+        if (!_file.is_open()) {
+            throw std::runtime_error("Erro ao abrir o arquivo de estatísticas!");
+        }
+        _front.reserve(STATS_BUFFER_BYTES);
+        _front += "generation,births,deaths,population,min_line,min_col,max_line,max_col\n";
+        _worker = std::thread(&StatsWriter::Run, this);
+    };
+
+    StatsWriter(const StatsWriter&) = delete;
+    StatsWriter& operator=(const StatsWriter&) = delete;
+
+    ~StatsWriter() {
+        HandOff();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _changed.notify_all();
+        _worker.join();
+        _file.flush();
+    };
+
+    void Push(const int generation, const GenerationStats& stats) {
+        char row[128];
+        const int length = snprintf(row, sizeof(row), "%d,%d,%d,%d,%d,%d,%d,%d\n", generation, stats.births,
+            stats.deaths, stats.population, stats.minLine, stats.minCol, stats.maxLine, stats.maxCol);
+        _front.append(row, length);
+
+        if (_front.size() >= STATS_BUFFER_BYTES) {
+            HandOff();
+        }
+    };
+
+private:
+    // Entrega o buffer cheio para a thread de escrita; só espera se o buffer anterior ainda não foi gravado
+    void HandOff() {
+        if (_front.empty()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        _changed.wait(lock, [this]() { return _back.empty(); });
+        _back.swap(_front);
+        lock.unlock();
+        _changed.notify_all();
+    };
+
+    void Run() {
+        std::string writing;
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _changed.wait(lock, [this]() { return !_back.empty() || _stopping; });
+            if (_back.empty()) {
+                break;
+            }
+            writing.swap(_back);
+            lock.unlock();
+            _file.write(writing.data(), static_cast<std::streamsize>(writing.size()));
+            writing.clear();
+            lock.lock();
+            _changed.notify_all();
+        }
+    };
+
+    std::ofstream _file;
+    std::string _front;
+    std::string _back;
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    bool _stopping;
+    std::thread _worker;
+};
+
+
+#endif //GAMEOFLIFE_STATISTICS_H
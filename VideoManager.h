@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <filesystem>
+#include <map>
 #include <string>
 #include <thread>
 #include <vector>
@@ -86,6 +88,30 @@ public:
         SDL_Surface* textSurface = TTF_RenderText_Solid(_font, text.c_str(), color);
         SDL_Texture* textTexture = SDL_CreateTextureFromSurface(_renderer, textSurface);
         SDL_RenderCopy(_renderer, textTexture, nullptr, &rect);
+        SDL_DestroyTexture(textTexture);
+        SDL_FreeSurface(textSurface);
+    };
+
+    // As miniaturas ficam em cache pela chave (o nome do arquivo) até o fim do programa
+    void DrawPreview(const SDL_Rect& rect, const std::string& key, const std::vector<Uint8>& preview, const int size) const {
+        auto cached = _previews.find(key);
+        if (cached == _previews.end()) {
+            std::vector<Uint32> pixels(preview.size());
+            std::transform(preview.begin(), preview.end(), pixels.begin(),
+                [](const Uint8 bit) { return bit ? 0xFFFFFFFFu : 0xFF202020u; });
+            SDL_Texture* texture = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, size, size);
+            SDL_UpdateTexture(texture, nullptr, pixels.data(), size * static_cast<int>(sizeof(Uint32)));
+            cached = _previews.emplace(key, texture).first;
+        }
+        SDL_RenderCopy(_renderer, cached->second, nullptr, &rect);
+        SDL_RenderDrawRect(_renderer, &rect);
+    };
+
+    void ReleasePreviews() const {
+        for (auto& preview : _previews) {
+            SDL_DestroyTexture(preview.second);
+        }
+        _previews.clear();
     };
 
     void SetWindowTitle(const std::string& title) const {
@@ -97,6 +123,7 @@ public:
     };
 
     void Terminate() const {
+        ReleasePreviews();
         SDL_DestroyRenderer(_renderer);
         SDL_DestroyWindow(_window);
         SDL_Quit();
@@ -150,6 +177,7 @@ private:
     SDL_Renderer* _renderer;
     SDL_Window* _window;
     TTF_Font* _font;
+    mutable std::map<std::string, SDL_Texture*> _previews;
 };
 
 
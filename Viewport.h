@@ -0,0 +1,113 @@
+#ifndef GAMEOFLIFE_VIEWPORT_H
+#define GAMEOFLIFE_VIEWPORT_H
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <SDL.h>
+
+#define MAX_ZOOM 64.0
+#define ZOOM_STEP 1.25
+#define PAN_STEP_PIXELS 40
+
+class Viewport {
+public:
+    Viewport() : Viewport(0, 0) {};
+
+    Viewport(const int pixelWidth, const int pixelHeight) : _pixelWidth(pixelWidth), _pixelHeight(pixelHeight),
+    _boardLines(1), _boardCols(1), _zoom(1.0), _originLine(0.0), _originCol(0.0) {};
+
+    // Enquadra o tabuleiro inteiro na área de desenho
+    void FitBoard(const int lines, const int cols) {
+        _boardLines = std::max(lines, 1);
+        _boardCols = std::max(cols, 1);
+        _zoom = FitZoom();
+        _originLine = 0.0;
+        _originCol = 0.0;
+        Clamp();
+    };
+
+    void Pan(const int dxPixels, const int dyPixels) {
+        _originCol -= dxPixels / _zoom;
+        _originLine -= dyPixels / _zoom;
+        Clamp();
+    };
+
+    // Aplica o zoom mantendo fixa a célula que está sob o ponto (x, y) da tela
+    void ZoomAt(const double factor, const int x, const int y) {
+        const double anchorCol = _originCol + x / _zoom;
+        const double anchorLine = _originLine + y / _zoom;
+
+        _zoom = std::clamp(_zoom * factor, FitZoom(), std::max(FitZoom(), MAX_ZOOM));
+        _originCol = anchorCol - x / _zoom;
+        _originLine = anchorLine - y / _zoom;
+        Clamp();
+    };
+
+    [[nodiscard]] bool ScreenToCell(const int x, const int y, int& line, int& col) const {
+        if (x < 0 || y < 0 || x >= _pixelWidth || y >= _pixelHeight) {
+            return false;
+        }
+        line = static_cast<int>(std::floor(_originLine + y / _zoom));
+        col = static_cast<int>(std::floor(_originCol + x / _zoom));
+        return line >= 0 && col >= 0 && line < _boardLines && col < _boardCols;
+    };
+
+    [[nodiscard]] int CellToScreenX(const double col) const {
+        return static_cast<int>(std::floor((col - _originCol) * _zoom));
+    };
+
+    [[nodiscard]] int CellToScreenY(const double line) const {
+        return static_cast<int>(std::floor((line - _originLine) * _zoom));
+    };
+
+    [[nodiscard]] int FirstVisibleLine() const {
+        return std::max(static_cast<int>(std::floor(_originLine)), 0);
+    };
+
+    [[nodiscard]] int FirstVisibleCol() const {
+        return std::max(static_cast<int>(std::floor(_originCol)), 0);
+    };
+
+    // Exclusivos: a última linha/coluna visível é LastVisibleLine() - 1
+    [[nodiscard]] int LastVisibleLine() const {
+        return std::min(static_cast<int>(std::ceil(_originLine + _pixelHeight / _zoom)), _boardLines);
+    };
+
+    [[nodiscard]] int LastVisibleCol() const {
+        return std::min(static_cast<int>(std::ceil(_originCol + _pixelWidth / _zoom)), _boardCols);
+    };
+
+    [[nodiscard]] double GetZoom() const {
+        return _zoom;
+    };
+
+    [[nodiscard]] SDL_Rect GetScreenRect() const {
+        return {0, 0, _pixelWidth, _pixelHeight};
+    };
+
+private:
+    [[nodiscard]] double FitZoom() const {
+        return std::min(static_cast<double>(_pixelWidth) / _boardCols, static_cast<double>(_pixelHeight) / _boardLines);
+    };
+
+    // Impede que a visão saia do tabuleiro; se ele couber inteiro em um eixo, fica alinhado ao topo/esquerda
+    void Clamp() {
+        const double visibleCols = _pixelWidth / _zoom;
+        const double visibleLines = _pixelHeight / _zoom;
+        _originCol = std::clamp(_originCol, 0.0, std::max(_boardCols - visibleCols, 0.0));
+        _originLine = std::clamp(_originLine, 0.0, std::max(_boardLines - visibleLines, 0.0));
+    };
+
+    int _pixelWidth;
+    int _pixelHeight;
+    int _boardLines;
+    int _boardCols;
+    double _zoom;
+    double _originLine;
+    double _originCol;
+};
+
+
+#endif //GAMEOFLIFE_VIEWPORT_H
@@ -1,16 +1,24 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <thread>
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include "Matrix.h"
 #include "GameBoard.h"
+#include "History.h"
 #include "MenuManager.h"
+#include "SaveIndex.h"
+#include "SharedBoard.h"
+#include "Statistics.h"
+#include "Scheduler.h"
 #include "VideoManager.h"
+#include "Viewport.h"
 
 constexpr SDL_Color textColor = {255, 255, 255, 255};
 
@@ -19,123 +27,65 @@ void ReadFile(std::ifstream& inputFile, GameBoard<char>& board) {
     inputFile >> currentLine >> currentCol;
     board = GameBoard<char>(currentLine, currentCol);
 
+    Matrix<char> pattern(currentLine, currentCol);
+
     int liveCells;
     inputFile >> liveCells;
 
     for (int cell = 0; cell < liveCells; cell++) {
         inputFile >> currentLine >> currentCol;
-        board.CreateLife(currentLine, currentCol);
+        pattern(currentLine, currentCol) = TRUE_VALUE;
     }
+    board.PastePattern(pattern, 0, 0);
 };
 
-int main(const int argc, char ** argv) {
-    int maxGenerations = 100000;
-
-    int fileCount = 0;
-    std::ifstream fileCounterIn("auxi/fileCounter.txt");
-    if (!fileCounterIn.is_open()) {
-        throw std::runtime_error("Erro ao abrir arquivo de contagem!");
-    }
-    fileCounterIn >> fileCount;
-
-    if (TTF_Init() == -1) {
-        throw std::runtime_error("Erro ao inicializar sistema de texto!");
-    }
-    TTF_Font* textFont = TTF_OpenFont(fontPath.c_str(), FONT_SIZE);
-
-    if (!textFont) {
-        throw std::runtime_error("Erro ao carregar a fonte!");
-    }
-
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        SDL_Log("Erro ao inicializar o sistema de vídeo.");
-        return -1;
-    }
-
-    SDL_Window* window = SDL_CreateWindow(
-        "Game of Life",
-        SDL_WINDOWPOS_CENTERED,
-        SDL_WINDOWPOS_CENTERED,
-        WINDOW_WIDTH,
-        WINDOW_HEIGHT,
-        SDL_WINDOW_SHOWN
-        );
-
-    if (window == nullptr) {
-        SDL_Log("Erro ao criar a janela de vídeo.");
-        SDL_Quit();
-        return -1;
-    }
-
-    SDL_Renderer* renderer = SDL_CreateRenderer(
-        window,
-        -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
-        );
-
-    if (renderer == nullptr) {
-        SDL_Log("Erro ao criar o renderizador.");
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return -1;
-    }
-
-    GameBoard<char> board;
-    auto vm = VideoManager(renderer, window, textFont);
-    auto mm = MenuManager(vm, board);
-
-    std::ifstream inputFile;
-    std::string inputFileName =
-    mm.MainMenu(inputFile);
-
-    if (inputFileName.empty()) {
-        vm.Terminate();
-        return 0;
-    }
-
-    if (inputFileName != "0") {
-        inputFile.open(inputFileName);
-        ReadFile(inputFile, board);
-    }
-
+// Laço do jogo, igual para o tabuleiro dinâmico e para os de tamanho fixo
+template <typename Board>
+void RunGame(Board& board, VideoManager& vm, SDL_Renderer* renderer, SaveIndex& saveIndex, int& fileCount,
+    const int maxGenerations, const std::string& statsPath, const std::string& sharedName) {
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     int generation = 0;
     bool isRunning = true;
 
-    const int sizeRatioX = WINDOW_WIDTH / board.GetCols();
-    const int sizeRatioY = WINDOW_HEIGHT / board.GetLines();
-
-    const double srxF = static_cast<double>(WINDOW_WIDTH) / board.GetCols();
-    const double sryF = static_cast<double>(WINDOW_HEIGHT) / board.GetLines();
+    vm.SetWindowSize(WINDOW_WIDTH + WINDOW_WIDTH / 8, WINDOW_HEIGHT);
 
-    if (ceil(srxF) > sizeRatioX && ceil(sryF) > sizeRatioY) {
-        vm.SetWindowSize(board.GetCols() * sizeRatioX + WINDOW_WIDTH / 8, board.GetLines() * sizeRatioY);
-    }
-
-    else if (ceil(sryF) > sizeRatioY) {
-        vm.SetWindowSize(WINDOW_WIDTH + WINDOW_WIDTH / 8, board.GetLines() * sizeRatioY);
-    }
-
-    else if (ceil(srxF) > sizeRatioX) {
-        vm.SetWindowSize(board.GetCols() * sizeRatioX + WINDOW_WIDTH / 8, WINDOW_HEIGHT);
-    }
-
-    else {
-        vm.SetWindowSize(WINDOW_WIDTH + WINDOW_WIDTH / 8, WINDOW_HEIGHT);
-    }
+    Viewport view(WINDOW_WIDTH, WINDOW_HEIGHT);
+    view.FitBoard(board.GetLines(), board.GetCols());
 
     bool paused = false;
     bool mouseHeldLeft = false;
     bool mouseHeldRight = false;
     bool mouseHeldMiddle = false;
+    bool panning = false;
 
     int circleRadius = WINDOW_WIDTH / 20;
     SDL_Point circleCenter = {WINDOW_WIDTH + WINDOW_WIDTH / 16, WINDOW_HEIGHT / 2};
+    const int circleTop = WINDOW_HEIGHT / 4 + circleRadius;
+    const int circleBottom = WINDOW_HEIGHT * 3 / 4 - circleRadius;
 
-    while (isRunning && generation <= maxGenerations) {
-        if (!paused) {
-            generation++;
-        }
+    std::unique_ptr<StatsWriter> statsWriter;
+    if (!statsPath.empty()) {
+        statsWriter = std::make_unique<StatsWriter>(statsPath);
+    }
+
+    std::unique_ptr<SharedBoardPublisher> publisher;
+    if (!sharedName.empty()) {
+        publisher = std::make_unique<SharedBoardPublisher>(sharedName, board);
+        publisher->Publish(generation, board);
+    }
+    // Marcado por tudo que muda o tabuleiro depois da publicação inicial
+    bool boardChanged = false;
+
+    BoardHistory history;
+    history.Record(generation, board);
+    bool boardEdited = false;
+
+    GenerationScheduler scheduler;
+    scheduler.SetTarget(GenerationScheduler::TargetFromPosition(
+        static_cast<double>(circleBottom - circleCenter.y) / (circleBottom - circleTop)));
+
+    while (isRunning && generation < maxGenerations) {
+        scheduler.BeginFrame(paused);
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
             switch (event.type) {
@@ -144,20 +94,20 @@ int main(const int argc, char ** argv) {
                     break;
                 case SDL_MOUSEBUTTONDOWN:
                     if (event.button.button == SDL_BUTTON_LEFT) {
-                        int mouseX = event.button.x;
-                        int mouseY = event.button.y;
-
-                        if (mouseX < WINDOW_WIDTH && mouseY < WINDOW_HEIGHT) {
-                            board.CreateLife(mouseY / sizeRatioY, mouseX / sizeRatioX);
+                        int line, col;
+                        if (view.ScreenToCell(event.button.x, event.button.y, line, col)) {
+                            board.CreateLife(line, col);
+                            boardEdited = true;
+                            boardChanged = true;
                         }
                         mouseHeldLeft = true;
                     }
                     else if (event.button.button == SDL_BUTTON_RIGHT) {
-                        int mouseX = event.button.x;
-                        int mouseY = event.button.y;
-
-                        if (mouseX < WINDOW_WIDTH && mouseY < WINDOW_HEIGHT) {
-                            board.DestroyLife(mouseY / sizeRatioY, mouseX / sizeRatioX);
+                        int line, col;
+                        if (view.ScreenToCell(event.button.x, event.button.y, line, col)) {
+                            board.DestroyLife(line, col);
+                            boardEdited = true;
+                            boardChanged = true;
                         }
                         mouseHeldRight = true;
                     }
@@ -168,6 +118,9 @@ int main(const int argc, char ** argv) {
                         if (PointInCircle({mouseX, mouseY}, circleCenter, circleRadius)) {
                             mouseHeldMiddle = true;
                         }
+                        else if (mouseX < WINDOW_WIDTH) {
+                            panning = true;
+                        }
                     }
                     break;
 
@@ -180,31 +133,54 @@ int main(const int argc, char ** argv) {
                     }
                     if (event.button.button == SDL_BUTTON_MIDDLE) {
                         mouseHeldMiddle = false;
+                        panning = false;
+                    }
+                    // Cada traço de edição vira um quadro do histórico, para poder ser desfeito com Z
+                    if (boardEdited && !mouseHeldLeft && !mouseHeldRight) {
+                        history.Record(generation, board);
+                        boardEdited = false;
                     }
                     break;
 
+                case SDL_MOUSEWHEEL: {
+                    int mouseX, mouseY;
+                    SDL_GetMouseState(&mouseX, &mouseY);
+                    if (mouseX < WINDOW_WIDTH && event.wheel.y != 0) {
+                        view.ZoomAt(event.wheel.y > 0 ? ZOOM_STEP : 1.0 / ZOOM_STEP, mouseX, mouseY);
+                    }
+                    break;
+                }
+
                 case SDL_MOUSEMOTION:
                     if (mouseHeldLeft) {
-                        int mouseX = event.motion.x;
-                        int mouseY = event.motion.y;
-                        if (mouseX < WINDOW_WIDTH && mouseY < WINDOW_HEIGHT && mouseX >= 0 && mouseY >= 0) {
-                            board.CreateLife(mouseY / sizeRatioY, mouseX / sizeRatioX);
+                        int line, col;
+                        if (view.ScreenToCell(event.motion.x, event.motion.y, line, col)) {
+                            board.CreateLife(line, col);
+                            boardEdited = true;
+                            boardChanged = true;
                         }
                     }
 
                     else if (mouseHeldRight) {
-                        int mouseX = event.motion.x;
-                        int mouseY = event.motion.y;
-                        if (mouseX < WINDOW_WIDTH && mouseY < WINDOW_HEIGHT && mouseX >= 0 && mouseY >= 0) {
-                            board.DestroyLife(mouseY / sizeRatioY, mouseX / sizeRatioX);
+                        int line, col;
+                        if (view.ScreenToCell(event.motion.x, event.motion.y, line, col)) {
+                            board.DestroyLife(line, col);
+                            boardEdited = true;
+                            boardChanged = true;
                         }
                     }
 
+                    else if (panning) {
+                        view.Pan(event.motion.xrel, event.motion.yrel);
+                    }
+
                     else if (mouseHeldMiddle) {
                         int mouseY = event.motion.y;
 
                         if (mouseY + circleRadius <= WINDOW_HEIGHT * 3 / 4 && mouseY - circleRadius >= WINDOW_HEIGHT * 1 / 4) {
                             circleCenter.y = mouseY;
+                            scheduler.SetTarget(GenerationScheduler::TargetFromPosition(
+                                static_cast<double>(circleBottom - circleCenter.y) / (circleBottom - circleTop)));
                         }
                     }
 
@@ -213,12 +189,54 @@ int main(const int argc, char ** argv) {
                     if (event.key.keysym.sym == SDLK_SPACE) {
                         paused = !paused;
                     }
+                    if (event.key.keysym.sym == SDLK_z) {
+                        paused = true;
+                        // Um traço ainda em andamento é gravado antes, para que o retrocesso comece por ele
+                        if (boardEdited) {
+                            history.Record(generation, board);
+                            boardEdited = false;
+                        }
+                        if (history.StepBack(generation, board)) {
+                            boardChanged = true;
+                        }
+                    }
+                    if (event.key.keysym.sym == SDLK_r) {
+                        board.RandomSoup(0, 0, board.GetLines(), board.GetCols(), DEFAULT_SOUP_DENSITY,
+                            static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+                        history.Record(generation, board);
+                        boardChanged = true;
+                    }
+                    if (event.key.keysym.sym == SDLK_c) {
+                        board.ClearRect(0, 0, board.GetLines(), board.GetCols());
+                        history.Record(generation, board);
+                        boardChanged = true;
+                    }
+                    if (event.key.keysym.sym == SDLK_t) {
+                        scheduler.ToggleTurbo();
+                    }
+                    if (event.key.keysym.sym == SDLK_LEFT) {
+                        view.Pan(PAN_STEP_PIXELS, 0);
+                    }
+                    if (event.key.keysym.sym == SDLK_RIGHT) {
+                        view.Pan(-PAN_STEP_PIXELS, 0);
+                    }
+                    if (event.key.keysym.sym == SDLK_UP) {
+                        view.Pan(0, PAN_STEP_PIXELS);
+                    }
+                    if (event.key.keysym.sym == SDLK_DOWN) {
+                        view.Pan(0, -PAN_STEP_PIXELS);
+                    }
+                    if (event.key.keysym.sym == SDLK_HOME) {
+                        view.FitBoard(board.GetLines(), board.GetCols());
+                    }
                     if (event.key.keysym.sym == SDLK_BACKSPACE) {
                         fileCount++;
-                        std::string outFilename = "saves/saved_file_" + std::to_string(fileCount) + ".txt";
-                        std::ofstream outputFile(outFilename);
+                        std::string outFilename = "saved_file_" + std::to_string(fileCount) + ".txt";
+                        std::ofstream outputFile(savesPath + "/" + outFilename);
                         board.SaveToFile(outputFile);
                         outputFile.close();
+                        saveIndex.Record(savesPath, outFilename, board);
+                        saveIndex.Store();
                         std::cout << "Dados da geração " << generation << " salvos no arquivo " << outFilename << "\n";
                     }
                     break;
@@ -227,21 +245,154 @@ int main(const int argc, char ** argv) {
             }
         }
 
-        std::string windowTitle = "Game of Life - Generation " + std::to_string(generation);
+        while (!paused && generation < maxGenerations && scheduler.ShouldStep()) {
+            board.AdvanceBoardState();
+            generation++;
+            boardChanged = true;
+            if (statsWriter) {
+                statsWriter->Push(generation, board.GetLastStats());
+            }
+            history.Record(generation, board);
+            scheduler.StepDone();
+        }
+
+        // Publica uma vez por quadro, e só se o tabuleiro mudou (por gerações, edições ou retrocesso)
+        if (publisher && boardChanged) {
+            publisher->Publish(generation, board);
+        }
+        boardChanged = false;
+
+        if (!scheduler.ShouldRender()) {
+            continue;
+        }
+
+        char rateText[64];
+        if (scheduler.IsTurbo()) {
+            snprintf(rateText, sizeof(rateText), " - %.1f ger/s (Turbo)", scheduler.GetAchievedRate());
+        }
+        else {
+            snprintf(rateText, sizeof(rateText), " - %.1f ger/s (alvo %.1f)", scheduler.GetAchievedRate(), scheduler.GetTarget());
+        }
+        std::string windowTitle = "Game of Life - Generation " + std::to_string(generation) + rateText;
+        if (history.IsOverLimit()) {
+            windowTitle += " - Z desativado (tabuleiro grande demais para o histórico)";
+        }
         if (paused) windowTitle += " (Pausado)";
         vm.SetWindowTitle(windowTitle);
 
-        board.Render(renderer, sizeRatioX, sizeRatioY);
+        board.Render(renderer, view);
         vm.RenderDrawCircle(circleCenter, circleRadius);
         vm.RenderPresent();
+    }
 
-        if (!paused) {
-            board.AdvanceBoardState();
-            int msDelay = circleCenter.y * circleCenter.y / WINDOW_HEIGHT;
-            std::this_thread::sleep_for(std::chrono::milliseconds(msDelay));
+
+    std::cout << "A simulação durou por " << generation << " gerações, e terminou com " << board.GetCurrentCount()
+    << " células vivas. No total, a vida foi criada " << board.GetTotalCount() << " vezes.\n";
+};
+
+// Os tamanhos do menu rodam em tabuleiros de tamanho fixo, com as células copiadas do tabuleiro lido ou criado
+template <int Size>
+GameBoard<char, Size, Size> ToFixedBoard(const GameBoard<char>& board) {
+    GameBoard<char, Size, Size> fixedBoard;
+    fixedBoard.UnpackCells(board.PackCells(), board.GetTotalCount());
+    return fixedBoard;
+};
+
+int main(const int argc, char ** argv) {
+    int maxGenerations = 100000;
+
+    std::string statsPath;
+    std::string sharedName;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--stats" && i + 1 < argc) {
+            statsPath = argv[++i];
+        }
+        else if (argument == "--shm" && i + 1 < argc) {
+            sharedName = argv[++i];
         }
     }
 
+    int fileCount = 0;
+    std::ifstream fileCounterIn("auxi/fileCounter.txt");
+    if (!fileCounterIn.is_open()) {
+        throw std::runtime_error("Erro ao abrir arquivo de contagem!");
+    }
+    fileCounterIn >> fileCount;
+
+    if (TTF_Init() == -1) {
+        throw std::runtime_error("Erro ao inicializar sistema de texto!");
+    }
+    TTF_Font* textFont = TTF_OpenFont(fontPath.c_str(), FONT_SIZE);
+
+    if (!textFont) {
+        throw std::runtime_error("Erro ao carregar a fonte!");
+    }
+
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_Log("Erro ao inicializar o sistema de vídeo.");
+        return -1;
+    }
+
+    SDL_Window* window = SDL_CreateWindow(
+        "Game of Life",
+        SDL_WINDOWPOS_CENTERED,
+        SDL_WINDOWPOS_CENTERED,
+        WINDOW_WIDTH,
+        WINDOW_HEIGHT,
+        SDL_WINDOW_SHOWN
+        );
+
+    if (window == nullptr) {
+        SDL_Log("Erro ao criar a janela de vídeo.");
+        SDL_Quit();
+        return -1;
+    }
+
+    SDL_Renderer* renderer = SDL_CreateRenderer(
+        window,
+        -1,
+        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
+        );
+
+    if (renderer == nullptr) {
+        SDL_Log("Erro ao criar o renderizador.");
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return -1;
+    }
+
+    GameBoard<char> board;
+    auto vm = VideoManager(renderer, window, textFont);
+    SaveIndex saveIndex;
+    saveIndex.Load();
+    auto mm = MenuManager(vm, board, saveIndex);
+
+    std::ifstream inputFile;
+    std::string inputFileName =
+    mm.MainMenu(inputFile);
+
+    if (inputFileName.empty()) {
+        vm.Terminate();
+        return 0;
+    }
+
+    if (inputFileName != "0") {
+        inputFile.open(inputFileName);
+        ReadFile(inputFile, board);
+    }
+
+    auto runGame = [&](auto&& gameBoard) {
+        RunGame(gameBoard, vm, renderer, saveIndex, fileCount, maxGenerations, statsPath, sharedName);
+    };
+    switch (board.GetLines() == board.GetCols() ? board.GetLines() : 0) {
+        case 10: runGame(ToFixedBoard<10>(board)); break;
+        case 25: runGame(ToFixedBoard<25>(board)); break;
+        case 50: runGame(ToFixedBoard<50>(board)); break;
+        case 100: runGame(ToFixedBoard<100>(board)); break;
+        default: runGame(board); break;
+    }
+
     vm.Terminate();
 
     fileCounterIn.close();
@@ -254,8 +405,5 @@ int main(const int argc, char ** argv) {
     fileCounterOut.close();
     inputFile.close();
 
-    std::cout << "A simulação durou por " << generation << " gerações, e terminou com " << board.GetCurrentCount()
-    << " células vivas. No total, a vida foi criada " << board.GetTotalCount() << " vezes.\n";
-
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,11 @@
+// Verificador dos motores de simulação, separado do jogo: não abre janela e retorna 0 só se todos os casos baterem
+// com a referência. Registrado no CTest em CMakeLists.txt.
+#define SDL_MAIN_HANDLED
+
+#include <iostream>
+#include "EngineVerifier.h"
+
+int main() {
+    const EngineVerifier verifier;
+    return verifier.Run(EngineVerifier::DefaultCases(), std::cout) == 0 ? 0 : 1;
+}